@@ -1,197 +1,17 @@
-#include <cstddef>  // for size_t
-#include <cstring>  // optional, for memcpy
-#include <iostream> // optional, for debugging
-
-template <typename T> struct myiterator {
-    T *ptr;
-
-    // Constructor
-    myiterator(T *p = nullptr) : ptr(p) {}
-
-    // Pre-increment (++it)
-    myiterator &operator++() {
-        ++ptr;
-        return *this;
-    }
-
-    // Post-increment (it++)
-    myiterator operator++(int) {
-        myiterator temp = *this;
-        ++ptr;
-        return temp;
-    }
-
-    // Pre-decrement (--it)
-    myiterator &operator--() {
-        --ptr;
-        return *this;
-    }
-
-    // Post-decrement (it--)
-    myiterator operator--(int) {
-        myiterator temp = *this;
-        --ptr;
-        return temp;
-    }
-
-    // Dereference
-    T &operator*() const { return *ptr; }
-
-    // Equality
-    bool operator==(const myiterator &other) const { return ptr == other.ptr; }
-
-    // Inequality
-    bool operator!=(const myiterator &other) const {
-        return !(ptr == other.ptr);
-    }
-
-    // Move forward n positions
-    myiterator operator+(int n) const { return myiterator(ptr + n); }
-
-    // Move backward n positions
-    myiterator operator-(int n) const { return myiterator(ptr - n); }
-
-    // Distance between iterators
-    int operator-(const myiterator &other) const { return ptr - other.ptr; }
-
-    T &operator[](int index) const { return *(ptr + index); }
-};
-
-template <typename T> struct myvector {
-    T *data;         // Pointer to dynamically allocated array of T
-    size_t size;     // Number of elements currently used
-    size_t capacity; // Total allocated slots (not necessarily filled)
-    using iterator = myiterator<T>; // Define iterator type
-    using const_iterator =
-        myiterator<const T>; // Define iterator type for const
-
-    // Default constructor
-    myvector() : data(nullptr), size(0), capacity(0) {}
-
-    // Template copy constructor to allow conversion like myvector<int> to
-    // myvector<double>, etc.
-    template <typename U> myvector(const myvector<U> &other) {}
-
-    // Allocate memory
-    void allocate(size_t obj) {
-        data = static_cast<T *>(
-            ::operator new(obj * sizeof(T))); // raw allocation (uninitialized)
-        capacity = obj;
-    }
-
-    // Deallocate mempory
-    void deallocate(T *dataptr) { ::operator delete(dataptr); }
-
-    void mypush(const T &value) {
-        if (size == capacity) {
-            size_t new_capacity = (capacity == 0) ? 1 : capacity * 2;
-
-            // Allocate new memory
-            T *new_data =
-                static_cast<T *>(::operator new(new_capacity * sizeof(T)));
-
-            // Move or copy existing elements to new_data
-            for (size_t i = 0; i < size; ++i) {
-                // new(...) T(...) is placement new
-                new (new_data + i)
-                    T(std::move(data[i])); // move-construct: At memory address
-                                           // new_data + i, construct a T object
-                                           // using the moved value of data[i]
-                data[i].~T();              // explicitly call destructor
-            }
-
-            // Deallocate old memory
-            ::operator delete(data);
-
-            data = new_data;
-            capacity = new_capacity;
-        }
-        // Placement new for the new element
-        new (data + size) T(value);
-
-        ++size;
-    }
-
-    // Pop the last element
-    void mypop() {
-        if (size == 0)
-            return; // avoid underflow
-
-        // Call destructor for last element
-        data[size - 1].~T();
-        --size;
-    }
-
-    // General index access
-
-    // for non constant objects (can modify elements)
-    T &operator[](size_t index) { return data[index]; }
-
-    // for constant objects (read only access)
-    const T &operator[](size_t index) const { return data[index]; }
-
-    // for printing the vector
-    void myprint() {
-        for (size_t i = 0; i < size; ++i) {
-            std::cout << data[i] << " ";
-        }
-    }
-
-    // Using quick sort for sorting
-    void quicksort(size_t low, size_t high, bool descending) {
-        if (low >= high)
-            return;
-
-        size_t pivotIndex = partition(low, high, descending);
-        if (pivotIndex > 0)
-            quicksort(low, pivotIndex - 1, descending);
-        quicksort(pivotIndex + 1, high, descending);
-    }
-
-    size_t partition(size_t low, size_t high, bool descending) {
-        T &pivot = data[high];
-        size_t i = low;
-
-        for (size_t j = low; j < high; ++j) {
-            bool condition = descending ? (data[j] > pivot) : (data[j] < pivot);
-            if (condition) {
-                std::swap(data[i], data[j]);
-                ++i;
-            }
-        }
-        std::swap(data[i], data[high]);
-        return i;
-    }
-
-    void mysort(bool descending = false) {
-        if (size > 1)
-            quicksort(0, size - 1, descending);
-    }
-
-    // manual clearing
-    void clear() {
-        for (size_t i = 0; i < size; ++i)
-            data[i].~T();
-        size = 0;
-    }
-
-    // begin(): returns iterator to first element
-    iterator begin() { return iterator(data); }
-
-    // end(): returns iterator to one-past-last element
-    iterator end() { return iterator(data + size); }
-
-    const_iterator begin() const { return const_iterator(data); }
-    const_iterator end() const { return const_iterator(data + size); }
-
-    // Destructor to release memory
-    ~myvector() {
-        for (size_t i = 0; i < size; ++i) {
-            data[i].~T(); // manually destroy each object
-        }
-        deallocate(data);
-    }
-};
+#include "concurrent_vector.hpp"
+#include "market_data_tick.hpp"
+#include "myvector.hpp"
+#include "simd_kernels.hpp"
+#include "small_vector.hpp"
+#include "vm_allocator.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 int main() {
     std::cout << "===== BEGIN TEST CASES =====\n\n";
@@ -278,6 +98,289 @@ int main() {
     }
     std::cout << "\n\n";
 
+    // Test 12: small_vector Stays Inline Up To N
+    std::cout << "Test 12: small_vector Stays Inline Up To N\n";
+    small_vector<int, 4> sv;
+    for (int i = 1; i <= 4; ++i)
+        sv.mypush(i);
+    std::cout << "Expected: 1 2 3 4, inline = 1\nGot:      ";
+    sv.myprint();
+    std::cout << ", inline = " << sv.is_inline() << "\n\n";
+
+    // Test 13: small_vector Spills To Heap Past N
+    std::cout << "Test 13: small_vector Spills To Heap Past N\n";
+    sv.mypush(5);
+    std::cout << "Expected: 1 2 3 4 5, inline = 0, capacity = 8\nGot:      ";
+    sv.myprint();
+    std::cout << ", inline = " << sv.is_inline()
+              << ", capacity = " << sv.capacity << "\n\n";
+
+    // Test 14: small_vector Copy Gets Its Own Inline Buffer
+    std::cout << "Test 14: small_vector Copy Gets Its Own Inline Buffer\n";
+    small_vector<std::string, 2> words;
+    words.mypush("bid");
+    words.mypush("ask");
+    small_vector<std::string, 2> words_copy = words;
+    words[0] = "last";
+    std::cout << "Expected: bid ask, inline = 1\nGot:      ";
+    words_copy.myprint();
+    std::cout << ", inline = " << words_copy.is_inline() << "\n\n";
+
+    // Test 15: reserve + emplace_back Constructs In Place
+    std::cout << "Test 15: reserve + emplace_back Constructs In Place\n";
+    myvector<std::string> sv2;
+    sv2.reserve(3);
+    std::string *before = sv2.data;
+    sv2.emplace_back(3, 'x'); // std::string(3, 'x')
+    sv2.emplace_back("ask");
+    sv2.emplace_back(sv2[0]); // argument lives inside the vector
+    bool kept_buffer = (sv2.data == before);
+    sv2.emplace_back(sv2[1]); // ... and this one forces a regrow
+    std::cout << "Expected: xxx ask xxx ask, first 3 kept buffer = 1, "
+                 "capacity = 6\nGot:      ";
+    sv2.myprint();
+    std::cout << ", first 3 kept buffer = " << kept_buffer
+              << ", capacity = " << sv2.capacity << "\n\n";
+
+    // Test 16: resize + shrink_to_fit
+    std::cout << "Test 16: resize + shrink_to_fit\n";
+    myvector<int> rv;
+    rv.resize(3);
+    rv.resize(5, 7);
+    rv.resize(4);
+    rv.shrink_to_fit();
+    std::cout << "Expected: 0 0 0 7, capacity = 4\nGot:      ";
+    rv.myprint();
+    std::cout << ", capacity = " << rv.capacity << "\n\n";
+
+    // Test 17: Over-Aligned MDT Survives Growth
+    std::cout << "Test 17: Over-Aligned MDT Survives Growth\n";
+    myvector<MDT> ticks;
+    MDT tick{};
+    for (int i = 0; i < 100; ++i) {
+        tick.timestamp_ns = i;
+        ticks.mypush(tick);
+    }
+    std::cout << "Expected: last ts = 99, 64-byte aligned = 1\nGot:      "
+              << "last ts = " << ticks[99].timestamp_ns
+              << ", 64-byte aligned = "
+              << ((reinterpret_cast<uintptr_t>(ticks.data) % 64) == 0)
+              << "\n\n";
+
+    // Test 18: Sort Already-Sorted and Few-Unique Input
+    std::cout << "Test 18: Sort Already-Sorted and Few-Unique Input\n";
+    myvector<int> big;
+    for (int i = 0; i < 1000000; ++i)
+        big.mypush(i % 2 ? i : 1000000 - i); // organ-pipe-ish pattern
+    big.mysort();
+    bool big_sorted = true;
+    for (size_t i = 1; i < big.size; ++i)
+        big_sorted = big_sorted && big[i - 1] <= big[i];
+    big.mysort(); // now sorted, must not go quadratic or blow the stack
+    big.mysort(true);
+    myvector<int> few;
+    for (int i = 0; i < 100000; ++i)
+        few.mypush(i % 3);
+    few.mysort_parallel();
+    std::cout << "Expected: sorted = 1, descending front = 1000000, few-unique "
+                 "= 0 .. 2\nGot:      sorted = "
+              << big_sorted << ", descending front = " << big[0]
+              << ", few-unique = " << few[0] << " .. " << few[few.size - 1]
+              << "\n\n";
+
+    // Test 19: Sort MDT By Timestamp
+    std::cout << "Test 19: Sort MDT By Timestamp\n";
+    for (size_t i = 0; i < ticks.size; ++i)
+        ticks[i].timestamp_ns = (i * 37) % ticks.size;
+    ticks.mysort_by([](const MDT &a, const MDT &b) {
+        return a.timestamp_ns < b.timestamp_ns;
+    });
+    std::cout << "Expected: 0 1 2 .. 99\nGot:      " << ticks[0].timestamp_ns
+              << " " << ticks[1].timestamp_ns << " " << ticks[2].timestamp_ns
+              << " .. " << ticks[99].timestamp_ns << "\n\n";
+
+    // Test 20: Radix Sort For Doubles With Negatives
+    std::cout << "Test 20: Radix Sort For Doubles With Negatives\n";
+    myvector<double> prices;
+    for (int i = 0; i < 1000; ++i)
+        prices.mypush((i % 2 ? -0.25 : 0.5) * ((i * 7919) % 1000));
+    prices.mysort();
+    bool prices_sorted = true;
+    for (size_t i = 1; i < prices.size; ++i)
+        prices_sorted = prices_sorted && prices[i - 1] <= prices[i];
+    std::cout << "Expected: sorted = 1, min = -249.75, max = 499\nGot:      "
+              << "sorted = " << prices_sorted << ", min = " << prices[0]
+              << ", max = " << prices[prices.size - 1] << "\n\n";
+
+    // Test 21: Radix Sort MDT By Key Is Stable
+    std::cout << "Test 21: Radix Sort MDT By Key Is Stable\n";
+    myvector<MDT> feed;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        tick.timestamp_ns = 1000 - i / 4; // groups of 4 equal timestamps
+        tick.bid_size = i;                // original position
+        feed.mypush(tick);
+    }
+    feed.mysort_by_key([](const MDT &t) { return t.timestamp_ns; });
+    std::cout << "Expected: first ts = 751, bid sizes = 996 997 998 999\n"
+              << "Got:      first ts = " << feed[0].timestamp_ns
+              << ", bid sizes = " << feed[0].bid_size << " " << feed[1].bid_size
+              << " " << feed[2].bid_size << " " << feed[3].bid_size << "\n\n";
+
+    // Test 22: SIMD Int Kernels Agree On Every ISA
+    std::cout << "Test 22: SIMD Int Kernels Agree On Every ISA\n";
+    myvector<int> nums;
+    for (int i = 0; i < 1003; ++i) // odd length so every kernel hits its tail
+        nums.mypush((i * 7919) % 2001 - 1000);
+    nums[1001] = 5000;
+    nums[17] = -5000;
+    bool ints_agree = true;
+    for (simd_isa isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2,
+                         simd_isa::avx512}) {
+        if (!simd_use(isa))
+            continue;
+        ints_agree = ints_agree && simd_sum(nums) == 4580 &&
+                     simd_min(nums) == -5000 && simd_max(nums) == 5000 &&
+                     simd_find(nums, 5000) == 1001 &&
+                     simd_find(nums, 12345) == nums.size &&
+                     simd_count(nums, -1000) == 1;
+    }
+    simd_use(simd_detect());
+    std::cout << "Expected: agree = 1, sum = 4580\nGot:      agree = "
+              << ints_agree << ", sum = " << simd_sum(nums) << "\n\n";
+
+    // Test 23: SIMD Double Sum Is Bit-Identical On Every ISA
+    std::cout << "Test 23: SIMD Double Sum Is Bit-Identical On Every ISA\n";
+    myvector<double> xs;
+    for (int i = 0; i < 1003; ++i)
+        xs.mypush(1.0 / (i + 1) * (i % 3 ? 1e8 : -1e-8));
+    simd_use(simd_isa::scalar);
+    double reference = simd_sum(xs);
+    bool doubles_agree = true;
+    for (simd_isa isa : {simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        if (!simd_use(isa))
+            continue;
+        double got = simd_sum(xs);
+        doubles_agree = doubles_agree &&
+                        std::memcmp(&got, &reference, sizeof got) == 0 &&
+                        simd_count(xs, xs[500]) == 1 &&
+                        simd_find(xs, xs[999]) == 999 &&
+                        simd_max(xs) == 5e7 && simd_min(xs) == -1e-8;
+    }
+    simd_use(simd_detect());
+    std::cout << "Expected: identical = 1\nGot:      identical = "
+              << doubles_agree << "\n\n";
+
+    // Test 24: pmr_myvector Lives In A Scratch Arena
+    std::cout << "Test 24: pmr_myvector Lives In A Scratch Arena\n";
+    {
+        // null upstream: anything that doesn't fit the scratch buffer throws
+        alignas(64) char scratch[4096];
+        std::pmr::monotonic_buffer_resource arena(
+            scratch, sizeof scratch, std::pmr::null_memory_resource());
+        alignas(64) char other_scratch[4096];
+        std::pmr::monotonic_buffer_resource other_arena(
+            other_scratch, sizeof other_scratch,
+            std::pmr::null_memory_resource());
+
+        pmr_myvector<int> ids(&arena);
+        for (int i = 0; i < 100; ++i)
+            ids.mypush(i);
+        pmr_myvector<int> moved(std::move(ids)); // takes the buffer
+        pmr_myvector<int> elsewhere(&other_arena);
+        elsewhere = std::move(moved); // other arena: copies element-wise
+        pmr_myvector<int> copied(elsewhere); // pmr copies don't propagate
+
+        pmr_myvector<std::pmr::string> names(&arena);
+        names.emplace_back("longer than the small string buffer");
+        std::cout << "Expected: 100 99 1 1 1\nGot:      " << elsewhere.size
+                  << " " << elsewhere[99] << " "
+                  << (elsewhere.get_allocator().resource() == &other_arena)
+                  << " "
+                  << (copied.get_allocator().resource() ==
+                      std::pmr::get_default_resource())
+                  << " "
+                  << (names[0].get_allocator().resource() == &arena)
+                  << "\n\n";
+    }
+
+    // Test 25: vm_allocator Grows Without Moving
+    std::cout << "Test 25: vm_allocator Grows Without Moving\n";
+    myvector<MDT, vm_allocator<MDT>> history(
+        vm_allocator<MDT>(size_t(64) << 20, page_mode::small));
+    history.mypush(tick);
+    MDT *first_buffer = history.data;
+    for (uint64_t i = 0; i < 500000; ++i) {
+        tick.timestamp_ns = i;
+        history.mypush(tick);
+    }
+    bool never_moved = history.data == first_buffer;
+    history.resize(1000);
+    history.shrink_to_fit();
+    std::cout << "Expected: moved = 0, capacity = 1000, ts[999] = 998\n"
+              << "Got:      moved = "
+              << !(never_moved && history.data == first_buffer)
+              << ", capacity = " << history.capacity
+              << ", ts[999] = " << history[999].timestamp_ns << "\n\n";
+
+    // Test 26: concurrent_vector Takes Appends From Several Threads
+    std::cout << "Test 26: concurrent_vector Takes Appends From Several Threads\n";
+    concurrent_vector<long> shared;
+    long &first_slot = shared[shared.mypush(-1)];
+    std::vector<std::thread> writers;
+    for (long t = 0; t < 4; ++t)
+        writers.emplace_back([&shared, t] {
+            for (long i = 0; i < 10000; ++i)
+                shared.mypush(t * 10000 + i);
+        });
+    for (std::thread &w : writers)
+        w.join();
+    long shared_sum = 0;
+    for (size_t i = 0; i < shared.size(); ++i)
+        shared_sum += shared.at(i);
+    std::cout << "Expected: size = 40001, sum = 799979999, first = -1\n"
+              << "Got:      size = " << shared.size() << ", sum = " << shared_sum
+              << ", first = " << first_slot << "\n\n";
+
+    // Test 27: small_vector Pushes Its Own Element And Moves Cheaply
+    std::cout << "Test 27: small_vector Pushes Its Own Element And Moves Cheaply\n";
+    small_vector<std::string, 2> names;
+    names.mypush("a long symbol name that is not in the SSO buffer");
+    names.mypush("second");
+    names.mypush(names[0]); // full: grows while copying its own element
+    std::string *heap_buffer = names.data;
+    std::vector<small_vector<std::string, 2>> books;
+    books.push_back(std::move(names));
+    small_vector<std::string, 2> short_list;
+    short_list.mypush("x");
+    small_vector<std::string, 2> moved_inline(std::move(short_list));
+    std::cout << "Expected: same = 1, stolen = 1, left = 0, inline = 1 x\nGot:      "
+              << "same = " << (books[0][2] == books[0][0])
+              << ", stolen = " << (books[0].data == heap_buffer)
+              << ", left = " << names.size
+              << ", inline = " << moved_inline.is_inline() << " "
+              << moved_inline[0] << "\n\n";
+
+    // Test 28: Sort By Key Is Stable Below The Radix Size, Any Key Type
+    std::cout << "Test 28: Sort By Key Is Stable Below The Radix Size, Any Key Type\n";
+    myvector<MDT> batch, by_pair;
+    for (uint32_t i = 0; i < 100; ++i) { // pdqsort range before the fix
+        tick.timestamp_ns = 100 - i / 4;
+        tick.last_price = 1.0 + i % 2;
+        tick.bid_size = i;
+        batch.mypush(tick);
+        by_pair.mypush(tick);
+    }
+    batch.mysort_by_key([](const MDT &t) { return t.timestamp_ns; });
+    by_pair.mysort_by_key([](const MDT &t) {
+        return std::make_pair(t.last_price, t.timestamp_ns);
+    });
+    std::cout << "Expected: bid sizes = 96 97 98 99, pair first = 1 76 96\n"
+              << "Got:      bid sizes = " << batch[0].bid_size << " "
+              << batch[1].bid_size << " " << batch[2].bid_size << " "
+              << batch[3].bid_size << ", pair first = " << by_pair[0].last_price
+              << " " << by_pair[0].timestamp_ns << " " << by_pair[0].bid_size
+              << "\n\n";
+
     std::cout << "===== END TEST CASES =====\n";
 
     return 0;
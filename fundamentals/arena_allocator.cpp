@@ -1,45 +1,179 @@
-// ------------------------------------- Placement new IMPLEMENTATION  -------------------------------------
+// ------------------------------------- Monotonic arena (arena_allocator.hpp) -------------------------------------
+#include "arena_allocator.hpp"
+#include "market_data_tick.hpp"
+#include "tracking_allocator.hpp"
+#include <cstdint>
 #include <iostream>
-#include <new>  // For placement new
+#include <memory_resource>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
 
-template<typename T>
-class arena_allocator {
-    char* buffer;
-    size_t capacity;
-    size_t offset;
+// A small non-MDT message to mix in with the ticks
+struct order_ack {
+    uint64_t order_id;
+    uint32_t status;
+};
+
+long page_faults() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+// Records the order destructors run in
+struct noisy {
+    std::string *log;
+    char name;
+    noisy(std::string *l, char n) : log(l), name(n) {}
+    ~noisy() { *log += name; }
+};
+
+int main() {
+    std::cout << "===== BEGIN TEST CASES =====\n\n";
+
+    arena_allocator arena(256);
+
+    // Test 1: Mixed Types Are Aligned
+    std::cout << "Test 1: Mixed Types Are Aligned\n";
+    char *tag = arena.make<char>('x');
+    MDT *tick = arena.make<MDT>();
+    order_ack *ack = arena.make<order_ack>(order_ack{42, 1});
+    std::cout << "Expected: MDT 64-aligned = 1, ack 8-aligned = 1, "
+                 "values = x 42\nGot:      MDT 64-aligned = "
+              << (reinterpret_cast<uintptr_t>(tick) % 64 == 0)
+              << ", ack 8-aligned = "
+              << (reinterpret_cast<uintptr_t>(ack) % alignof(order_ack) == 0)
+              << ", values = " << *tag << " " << ack->order_id << "\n\n";
 
-public:
-    arena_allocator(size_t count) : capacity(count * sizeof(T)), offset(0) {
-        buffer = new char[capacity];  // Allocate raw memory block
+    // Test 2: Full Block Chains A Bigger One
+    std::cout << "Test 2: Full Block Chains A Bigger One\n";
+    for (int i = 0; i < 10; ++i)
+        arena.make<MDT>();
+    char *big = static_cast<char *>(arena.allocate(5000, 1));
+    big[4999] = 'y';
+    // 256 -> 512 -> 1024 hold the MDTs, the 5000 bytes need 8192
+    std::cout << "Expected: blocks = 4, capacity = 9984\n"
+              << "Got:      blocks = " << arena.block_count()
+              << ", capacity = " << arena.capacity() << "\n\n";
+
+    // Test 3: reset Keeps Only The Newest Block
+    std::cout << "Test 3: reset Keeps Only The Newest Block\n";
+    arena.reset();
+    std::cout << "Expected: blocks = 1, used = 0\nGot:      blocks = "
+              << arena.block_count() << ", used = " << arena.used_in_block()
+              << "\n\n";
+
+    // Test 4: Nested Scopes Rewind And Reuse Memory
+    std::cout << "Test 4: Nested Scopes Rewind And Reuse Memory\n";
+    void *request_start;
+    void *reused;
+    size_t inside_batch;
+    {
+        arena_scope request(arena);
+        request_start = arena.allocate(100);
+        {
+            arena_scope batch(arena);
+            arena.allocate(200);
+            inside_batch = arena.used_in_block();
+        }
+        reused = arena.allocate(100);
     }
+    std::cout << "Expected: used inside batch = 312, after batch reuses = 1, "
+                 "used after request = 0\nGot:      used inside batch = "
+              << inside_batch << ", after batch reuses = "
+              << (reused == static_cast<char *>(request_start) + 112)
+              << ", used after request = " << arena.used_in_block() << "\n\n";
 
-    // Allocates memory and constructs an object of type T using placement new
-    template<typename... Args>
-    
-    T* allocate(Args&&... args) {
-        if (offset + sizeof(T) > capacity)
-            return nullptr;  // Out of space
-        
-        // Calculate where to place the next object
-        T* ptr = reinterpret_cast<T*>(buffer + offset);
-
-        // Construct the object in-place using placement new with forwarded arguments
-        new (ptr) T(std::forward<Args>(args)...);
-
-        offset += sizeof(T);  // Move offset forward
-        return ptr;
+    // Test 5: Destructors Run Newest First On Rollback
+    std::cout << "Test 5: Destructors Run Newest First On Rollback\n";
+    std::string log;
+    {
+        arena_scope request(arena);
+        arena.make<noisy>(&log, 'a');
+        {
+            arena_scope batch(arena);
+            arena.make<noisy>(&log, 'b');
+            arena.make<noisy>(&log, 'c');
+        }
+        log += '|';
+        arena.make<std::string>(200, 's'); // heap-owning, freed by rollback
+        arena.make<noisy>(&log, 'd');
     }
+    std::cout << "Expected: cb|da\nGot:      " << log << "\n\n";
 
-    // Reset allocator (does NOT call destructors)
-    void reset() {
-        offset = 0;
+    // Test 6: Trivially Destructible Types Skip The List
+    std::cout << "Test 6: Trivially Destructible Types Skip The List\n";
+    size_t before = arena.used_in_block();
+    arena.make<order_ack>(order_ack{7, 0});
+    size_t plain = arena.used_in_block() - before;
+    arena.reset();
+    arena.make<noisy>(&log, 'e');
+    size_t listed = arena.used_in_block();
+    arena.reset();
+    std::cout << "Expected: plain = 16, with destructor = 40, log = cb|dae\n"
+              << "Got:      plain = " << plain << ", with destructor = "
+              << listed << ", log = " << log << "\n\n";
+
+    // Test 7: Rollback Frees Chained Blocks, Keeps One Spare
+    std::cout << "Test 7: Rollback Frees Chained Blocks, Keeps One Spare\n";
+    size_t blocks_before = arena.block_count();
+    char *spilled;
+    {
+        arena_scope request(arena);
+        spilled = static_cast<char *>(arena.allocate(20000));
     }
+    size_t blocks_after = arena.block_count();
+    char *again = static_cast<char *>(arena.allocate(20000));
+    std::cout << "Expected: blocks = 1 1, spare reused = 1\nGot:      blocks = "
+              << blocks_before << " " << blocks_after
+              << ", spare reused = " << (again == spilled) << "\n\n";
 
-    ~arena_allocator() {
-        // Call destructors manually for all constructed objects if needed (not handled here)
-        delete[] buffer;
+    // Test 8: pmr Containers On The Arena, Counted By TrackingResource
+    std::cout << "Test 8: pmr Containers On The Arena, Counted By TrackingResource\n";
+    arena_resource on_arena(arena);
+    TrackingResource counted(&on_arena);
+    size_t used_before = arena.used_in_block();
+    {
+        std::pmr::vector<std::pmr::string> symbols(&counted);
+        symbols.reserve(4);
+        for (const char *s : {"ESZ5 front month future", "NQZ5 front month future",
+                              "CLF6 front month future"})
+            symbols.emplace_back(s); // the strings use the vector's resource
     }
-};
+    std::cout << "Expected: allocations = 4, frees = 4, bytes in use = 0, "
+                 "arena grew = 1\nGot:      allocations = "
+              << counted.get_allocations()
+              << ", frees = " << counted.get_deallocations()
+              << ", bytes in use = " << counted.get_bytes_in_use()
+              << ", arena grew = " << (arena.used_in_block() > used_before)
+              << "\n\n";
+
+    // Test 9: Prefaulted Mapped Arena Doesn't Fault On Use
+    std::cout << "Test 9: Prefaulted Mapped Arena Doesn't Fault On Use\n";
+    const size_t startup_bytes = 8 << 20;
+    arena_allocator lazy(startup_bytes);
+    arena_options prefaulted;
+    prefaulted.mapped = true;
+    arena_allocator ready(startup_bytes, prefaulted);
+    long faults_before = page_faults();
+    for (size_t i = 0; i < startup_bytes / 64; ++i)
+        ready.make<MDT>()->timestamp_ns = i;
+    long ready_faults = page_faults() - faults_before;
+    faults_before = page_faults();
+    for (size_t i = 0; i < startup_bytes / 64 - 1; ++i)
+        lazy.make<MDT>()->timestamp_ns = i;
+    long lazy_faults = page_faults() - faults_before;
+    std::cout << "Expected: prefaulted faults = 0, lazy faults > 1000 = 1, "
+                 "blocks = 1\nGot:      prefaulted faults = "
+              << ready_faults << ", lazy faults > 1000 = "
+              << (lazy_faults > 1000) << ", blocks = " << ready.block_count()
+              << "\n\n";
+
+    std::cout << "===== END TEST CASES =====\n";
+
+    return 0;
+}
 
 
 
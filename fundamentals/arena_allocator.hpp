@@ -0,0 +1,351 @@
+#pragma once
+#include "vm_allocator.hpp" // for page_mode, huge_page_size
+#include <cstddef>   // for size_t, max_align_t
+#include <cstdint>   // for uintptr_t
+#include <memory_resource> // for arena_resource
+#include <new>       // for placement new, bad_alloc
+#include <sys/mman.h> // for mmap, madvise, mlock
+#include <type_traits> // for std::is_trivially_destructible
+#include <utility>   // for std::forward
+
+/*
+    Where arena blocks come from. The default is operator new, whose pages
+    fault in lazily the first time each 4 KiB page is written, i.e. on the
+    hot path. mapped = true gets every block from mmap instead (huge pages
+    per pages, same fallback as vm_allocator), and prefault touches every
+    page when the block is made, so the faults happen up front; lock also
+    mlocks the block so it can't be swapped or reclaimed later (needs
+    RLIMIT_MEMLOCK, ignored if it fails, see pages_locked()). With mapped
+    blocks the arena also creates its first block in the constructor, size
+    initial_bytes for the startup working set.
+*/
+struct arena_options {
+    bool mapped = false;
+    page_mode pages = page_mode::transparent;
+    bool prefault = true;
+    bool lock = false;
+};
+
+/*
+    Monotonic (bump) arena for objects of any type.
+
+    - allocate(size, align) rounds the current offset up to align and bumps
+      it; make<T>(args...) does that with sizeof/alignof T and constructs in
+      place, so mixed message types and over-aligned ones like MDT
+      (alignas(64)) can share one arena
+    - memory comes in blocks; when the current one is full a new block
+      twice the size of the last (and at least big enough for the request)
+      is chained in front of it, nothing is ever moved
+    - there is no per-object free. reset() releases everything at once and
+      keeps the newest (largest) block so a steady-state arena stops
+      allocating; the destructor frees all blocks
+    - mark() saves the current position and rewind(m) goes back to it,
+      releasing everything allocated since; arena_scope does that on scope
+      exit, so per-request and per-batch scratch can nest. Blocks chained
+      in after the mark are freed, except the largest which is kept as a
+      spare for the next block the arena needs
+    - make<T> for a T that isn't trivially destructible also puts a small
+      node on an intrusive destructor list (in the arena, right before the
+      object). rewind, reset and the arena's destructor run those
+      destructors newest first; trivially destructible types cost nothing
+      extra. Objects from allocate()/allocate_array() are never destroyed
+*/
+class arena_allocator {
+    // Header at the start of every block, the usable bytes follow it
+    struct alignas(std::max_align_t) block {
+        block *prev;
+        size_t size;      // usable bytes
+        size_t map_bytes; // length of the mapping, 0 if from operator new
+    };
+
+    // Destructor list entry, newest first
+    struct dtor_node {
+        dtor_node *prev;
+        void (*destroy)(void *);
+        void *object;
+    };
+
+    block *current = nullptr; // newest block, the others hang off prev
+    char *ptr = nullptr;      // next free byte in current
+    char *end = nullptr;      // one past the last usable byte in current
+    size_t next_size;         // usable size of the next block to chain in
+    block *spare = nullptr;   // freed by a rewind, reused by grow
+    dtor_node *dtors = nullptr;
+    arena_options options;
+    bool locked = true;       // every mapped block got mlocked
+
+    // A new block with at least usable bytes after the header
+    block *new_block(size_t usable) {
+        if (!options.mapped) {
+            block *b =
+                static_cast<block *>(::operator new(sizeof(block) + usable));
+            b->size = usable;
+            b->map_bytes = 0;
+            return b;
+        }
+        size_t granule = options.pages == page_mode::small
+                             ? (size_t)sysconf(_SC_PAGESIZE)
+                             : huge_page_size;
+        size_t length = vm_allocator<char>::round_up(sizeof(block) + usable,
+                                                     granule);
+        char *base = nullptr;
+        if (options.pages == page_mode::explicit_huge) {
+            void *p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                               (options.prefault ? MAP_POPULATE : 0),
+                           -1, 0);
+            if (p != MAP_FAILED)
+                base = static_cast<char *>(p);
+        }
+        if (!base) {
+            // 2 MiB aligned so THPs can back it (see vm_allocator)
+            size_t padded = length + huge_page_size;
+            void *p = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            char *raw = static_cast<char *>(p);
+            base = reinterpret_cast<char *>(vm_allocator<char>::round_up(
+                reinterpret_cast<uintptr_t>(raw), huge_page_size));
+            if (base != raw)
+                munmap(raw, base - raw);
+            munmap(base + length, raw + padded - (base + length));
+            madvise(base, length,
+                    options.pages == page_mode::small ? MADV_NOHUGEPAGE
+                                                      : MADV_HUGEPAGE);
+            if (options.prefault) {
+                // One write per 4 KiB page; with THP the first write in
+                // each 2 MiB faults in the whole huge page
+                size_t page = (size_t)sysconf(_SC_PAGESIZE);
+                for (size_t off = 0; off < length; off += page)
+                    static_cast<volatile char *>(base)[off] = 0;
+            }
+        }
+        if (options.lock && mlock(base, length) != 0)
+            locked = false;
+        block *b = reinterpret_cast<block *>(base);
+        b->size = length - sizeof(block);
+        b->map_bytes = length;
+        return b;
+    }
+
+    static void release_block(block *b) {
+        if (!b)
+            return;
+        if (b->map_bytes)
+            munmap(b, b->map_bytes);
+        else
+            ::operator delete(b);
+    }
+
+    template <typename T> static void destroy_as(void *object) {
+        static_cast<T *>(object)->~T();
+    }
+
+    // Run destructors registered after stop, newest first
+    void run_dtors(dtor_node *stop) {
+        while (dtors != stop) {
+            dtors->destroy(dtors->object);
+            dtors = dtors->prev;
+        }
+    }
+
+    // Take current off the chain, keeping the biggest one as the spare
+    void pop_block() {
+        block *b = current;
+        current = b->prev;
+        if (!spare || b->size > spare->size) {
+            release_block(spare);
+            spare = b;
+        } else {
+            release_block(b);
+        }
+    }
+
+    static char *begin_of(block *b) { return reinterpret_cast<char *>(b + 1); }
+
+    static char *align_up(char *p, size_t align) {
+        uintptr_t v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char *>((v + align - 1) & ~(uintptr_t)(align - 1));
+    }
+
+    // Chain in a block with room for at least size bytes at align
+    void grow(size_t size, size_t align) {
+        size_t need = size + align; // worst-case padding
+        block *b;
+        if (spare && spare->size >= need) {
+            b = spare;
+            spare = nullptr;
+        } else {
+            size_t usable = next_size;
+            while (usable < need)
+                usable *= 2;
+            b = new_block(usable);
+            next_size = usable * 2;
+        }
+        b->prev = current;
+        current = b;
+        ptr = begin_of(b);
+        end = ptr + b->size;
+    }
+
+    static void free_chain(block *b) {
+        while (b) {
+            block *prev = b->prev;
+            release_block(b);
+            b = prev;
+        }
+    }
+
+  public:
+    // First block gets initial_bytes, later ones double
+    explicit arena_allocator(size_t initial_bytes = 64 * 1024)
+        : next_size(initial_bytes ? initial_bytes : 1) {}
+
+    // Mapped blocks: the first one is made (and prefaulted) right here
+    arena_allocator(size_t initial_bytes, const arena_options &opts)
+        : next_size(initial_bytes ? initial_bytes : 1), options(opts) {
+        if (options.mapped)
+            grow(0, 1);
+    }
+
+    arena_allocator(const arena_allocator &) = delete;
+    arena_allocator &operator=(const arena_allocator &) = delete;
+
+    // size bytes aligned to align (a power of two); never returns nullptr
+    void *allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        char *p = align_up(ptr, align);
+        if (!current || p + size > end) {
+            grow(size, align);
+            p = align_up(ptr, align);
+        }
+        ptr = p + size;
+        return p;
+    }
+
+    // Allocates and constructs a T in place, its destructor runs on
+    // rewind/reset
+    template <typename T, typename... Args> T *make(Args &&...args) {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            void *p = allocate(sizeof(T), alignof(T));
+            return new (p) T(std::forward<Args>(args)...);
+        } else {
+            dtor_node *node = static_cast<dtor_node *>(
+                allocate(sizeof(dtor_node), alignof(dtor_node)));
+            T *object = new (allocate(sizeof(T), alignof(T)))
+                T(std::forward<Args>(args)...);
+            // only registered once the constructor didn't throw
+            *node = {dtors, &destroy_as<T>, object};
+            dtors = node;
+            return object;
+        }
+    }
+
+    // Uninitialized room for n Ts
+    template <typename T> T *allocate_array(size_t n) {
+        return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // Position to come back to with rewind()
+    struct marker {
+        block *blk;
+        char *ptr;
+        dtor_node *dtors;
+    };
+
+    marker mark() const { return {current, ptr, dtors}; }
+
+    // Destroy and release everything allocated since m was taken. m must
+    // still be live (not rewound past, no reset since)
+    void rewind(const marker &m) {
+        run_dtors(m.dtors);
+        while (current != m.blk)
+            pop_block();
+        ptr = m.ptr;
+        end = current ? begin_of(current) + current->size : nullptr;
+    }
+
+    // Drop every object at once, keeps the newest block
+    void reset() {
+        run_dtors(nullptr);
+        if (!current)
+            return;
+        free_chain(current->prev);
+        current->prev = nullptr;
+        ptr = begin_of(current);
+        end = ptr + current->size;
+    }
+
+    // Bytes handed out from the current block (including alignment padding)
+    size_t used_in_block() const {
+        return current ? (size_t)(ptr - begin_of(current)) : 0;
+    }
+
+    // Number of blocks in the chain
+    size_t block_count() const {
+        size_t n = 0;
+        for (block *b = current; b; b = b->prev)
+            ++n;
+        return n;
+    }
+
+    // Usable bytes in all blocks
+    size_t capacity() const {
+        size_t bytes = 0;
+        for (block *b = current; b; b = b->prev)
+            bytes += b->size;
+        return bytes;
+    }
+
+    // False if lock was asked for and some block couldn't be mlocked
+    bool pages_locked() const { return options.lock && locked; }
+
+    ~arena_allocator() {
+        run_dtors(nullptr);
+        free_chain(current);
+        release_block(spare);
+    }
+};
+
+// Rewinds the arena to where it was when the scope was entered
+class arena_scope {
+    arena_allocator &arena;
+    arena_allocator::marker saved;
+
+  public:
+    explicit arena_scope(arena_allocator &a) : arena(a), saved(a.mark()) {}
+
+    arena_scope(const arena_scope &) = delete;
+    arena_scope &operator=(const arena_scope &) = delete;
+
+    ~arena_scope() { arena.rewind(saved); }
+};
+
+/*
+    arena_allocator as a std::pmr::memory_resource, so pmr containers
+    (std::pmr::vector/string/unordered_map, pmr_myvector, pmr_cqueue) can
+    allocate from it. Deallocation is a no-op, memory comes back with the
+    arena's reset()/rewind(); put an unsynchronized_pool_resource on top if
+    freed nodes should be recycled before that. Not thread-safe, like the
+    arena itself.
+*/
+class arena_resource : public std::pmr::memory_resource {
+    arena_allocator &arena;
+
+  public:
+    explicit arena_resource(arena_allocator &a) : arena(a) {}
+
+    arena_allocator &get_arena() const { return arena; }
+
+  protected:
+    void *do_allocate(size_t bytes, size_t align) override {
+        return arena.allocate(bytes, align);
+    }
+
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const
+        noexcept override {
+        return this == &other;
+    }
+};
@@ -0,0 +1,103 @@
+#include "arena_allocator.hpp"
+#include "market_data_tick.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Per-message allocation: every message needs a small header, an MDT
+// (alignas(64)) and a variable-size payload (16..256 bytes).
+// - per message: allocate the three, use them, drop them
+// - per batch: keep a whole batch of messages alive, then drop them all
+// new/delete frees object by object, the arena just calls reset().
+
+using namespace std;
+using namespace chrono;
+
+struct header {
+    uint64_t seq;
+    uint32_t type;
+};
+
+volatile uint64_t sink;
+
+template <typename F> double ns_per_alloc(size_t messages, F run) {
+    auto start_time = steady_clock::now();
+    run();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)dur.count() / (messages * 3);
+}
+
+int main(int argc, char **argv) {
+    size_t messages = (argc > 1) ? stoull(argv[1]) : 10000000;
+    size_t batch = (argc > 2) ? stoull(argv[2]) : 1000;
+
+    mt19937 rng(5);
+    vector<size_t> payload(4096);
+    for (size_t &p : payload)
+        p = 16 + rng() % 241;
+
+    cout << "messages = " << messages << ", batch = " << batch
+         << ", 3 allocations per message\n\n";
+    cout << "pattern\t\tnew/delete (ns/alloc)\tarena (ns/alloc)\n";
+
+    double heap_msg = ns_per_alloc(messages, [&] {
+        for (size_t i = 0; i < messages; ++i) {
+            header *h = new header{i, 1};
+            MDT *t = new MDT();
+            char *p = new char[payload[i & 4095]];
+            p[0] = (char)i;
+            sink = h->seq + t->bid_size + p[0];
+            delete[] p;
+            delete t;
+            delete h;
+        }
+    });
+    arena_allocator arena;
+    double arena_msg = ns_per_alloc(messages, [&] {
+        for (size_t i = 0; i < messages; ++i) {
+            header *h = arena.make<header>(header{i, 1});
+            MDT *t = arena.make<MDT>();
+            char *p = arena.allocate_array<char>(payload[i & 4095]);
+            p[0] = (char)i;
+            sink = h->seq + t->bid_size + p[0];
+            arena.reset();
+        }
+    });
+    cout << "per message\t" << heap_msg << "\t\t\t" << arena_msg << "\n";
+
+    vector<header *> hs(batch);
+    vector<MDT *> ts(batch);
+    vector<char *> ps(batch);
+    double heap_batch = ns_per_alloc(messages, [&] {
+        for (size_t i = 0; i < messages; i += batch) {
+            for (size_t j = 0; j < batch; ++j) {
+                hs[j] = new header{i + j, 1};
+                ts[j] = new MDT();
+                ps[j] = new char[payload[(i + j) & 4095]];
+            }
+            for (size_t j = 0; j < batch; ++j) {
+                sink = hs[j]->seq + ts[j]->bid_size;
+                delete[] ps[j];
+                delete ts[j];
+                delete hs[j];
+            }
+        }
+    });
+    double arena_batch = ns_per_alloc(messages, [&] {
+        for (size_t i = 0; i < messages; i += batch) {
+            for (size_t j = 0; j < batch; ++j) {
+                hs[j] = arena.make<header>(header{i + j, 1});
+                ts[j] = arena.make<MDT>();
+                ps[j] = arena.allocate_array<char>(payload[(i + j) & 4095]);
+            }
+            for (size_t j = 0; j < batch; ++j)
+                sink = hs[j]->seq + ts[j]->bid_size;
+            arena.reset();
+        }
+    });
+    cout << "per batch\t" << heap_batch << "\t\t\t" << arena_batch << "\n";
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "arena_allocator.hpp"
+#include "market_data_tick.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+// Startup latency of a fresh arena sized for the first messages (default
+// 64 MB): each message allocates an MDT plus a 192-byte payload and writes
+// both. Per backing option:
+// - setup: time to construct the arena (where prefaulting pays)
+// - first msg: latency of the very first message
+// - p50/p99/max: per-message allocation + write latency over all messages
+// - faults: page faults while handling the messages
+// heap = operator new block (faults lazily on the hot path); the mapped
+// ones prefault at setup. "mlock" also locks the pages (needs
+// RLIMIT_MEMLOCK, shown as "not locked" otherwise).
+
+using namespace std;
+using namespace chrono;
+
+long page_faults() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+void run(const string &name, size_t bytes, size_t messages, bool mapped,
+         page_mode pages, bool lock) {
+    auto setup_start = steady_clock::now();
+    arena_options opts;
+    opts.mapped = mapped;
+    opts.pages = pages;
+    opts.lock = lock;
+    arena_allocator arena(bytes, opts);
+    auto setup = duration_cast<microseconds>(steady_clock::now() - setup_start);
+
+    vector<long> ns(messages);
+    long faults_before = page_faults();
+    for (size_t i = 0; i < messages; ++i) {
+        auto start_time = steady_clock::now();
+        MDT *tick = arena.make<MDT>();
+        tick->timestamp_ns = i;
+        char *payload = arena.allocate_array<char>(192);
+        for (size_t b = 0; b < 192; b += 64)
+            payload[b] = (char)i;
+        ns[i] = duration_cast<nanoseconds>(steady_clock::now() - start_time)
+                    .count();
+    }
+    long faults = page_faults() - faults_before;
+    long first = ns[0];
+    sort(ns.begin(), ns.end());
+
+    cout << name << string(16 - name.size(), ' ') << setup.count() / 1000.0
+         << "\t\t" << first << "\t\t" << ns[messages / 2] << "\t"
+         << ns[messages * 99 / 100] << "\t" << ns[messages - 1] << "\t"
+         << faults;
+    if (lock && !arena.pages_locked())
+        cout << "  (not locked)";
+    cout << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t bytes = (argc > 1) ? stoull(argv[1]) : (size_t(64) << 20);
+    size_t messages = bytes / 256 - 1; // fill the first block, no chaining
+
+    cout << "arena = " << (bytes >> 20) << " MB, messages = " << messages
+         << "\n\n";
+    cout << "backing         setup (ms)\tfirst msg (ns)\tp50\tp99\tmax "
+            "(ns)\tfaults\n";
+    run("heap (lazy)", bytes, messages, false, page_mode::small, false);
+    run("mmap 4K", bytes, messages, true, page_mode::small, false);
+    run("mmap THP", bytes, messages, true, page_mode::transparent, false);
+    run("mmap hugetlb", bytes, messages, true, page_mode::explicit_huge, false);
+    run("mmap THP mlock", bytes, messages, true, page_mode::transparent, true);
+    return 0;
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include "object_pool.hpp"
+#include <atomic>    // for pool ids
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <memory>    // for std::unique_ptr
+#include <mutex>
+#include <utility>   // for std::swap, std::forward
+#include <vector>
+
+/*
+    Thread-safe front-end for object_pool: per-thread magazine caches in
+    front of one shared, mutex-guarded pool.
+
+    - every thread gets its own cache with two magazines (stacks of up to
+      MagazineSize free objects). allocate pops from the loaded one and
+      deallocate pushes onto it, no lock and no atomics on that path
+    - when both magazines are empty a whole magazine is refilled under the
+      lock, from the depot (free objects other threads gave back) first and
+      the slabs second; when both are full one full magazine goes back
+      under the lock. So a thread that only frees (a consumer freeing what
+      a producer allocated) returns memory in batches of MagazineSize, and
+      at most 2 * MagazineSize objects sit in any thread's cache
+    - the depot holds at most depot_limit objects, more go back onto the
+      slab pool's free list
+    - the cache is found through a small thread_local table keyed by a
+      never-reused pool id, so a thread can use several pools (and a pool
+      at a recycled address never sees a stale cache). A thread using more
+      than tls_entries pools evicts its least recently used entry: that
+      cache is flushed to its pool's depot (if the pool is still alive,
+      checked in a registry of live pools) and kept for reuse, so nothing
+      is stranded. Caches belong to the pool; objects in the cache of a
+      thread that has exited stay there until the pool dies, call
+      flush_thread_cache() before a worker exits to hand them back
+    - the pool must outlive every thread's last use of it
+*/
+template <typename T, size_t MagazineSize = 64, bool CacheAligned = false>
+class caching_pool {
+    struct magazine {
+        size_t count = 0;
+        T *items[MagazineSize];
+    };
+
+    struct thread_cache {
+        magazine mags[2];
+        magazine *loaded = &mags[0];
+        magazine *previous = &mags[1];
+    };
+
+    struct tls_entry {
+        uint64_t id;
+        thread_cache *cache;
+    };
+    static constexpr size_t tls_entries = 8;
+
+    std::mutex lock;
+    object_pool<T, CacheAligned> backend;
+    std::vector<T *> depot;
+    size_t depot_limit;
+    std::vector<std::unique_ptr<thread_cache>> caches;
+    std::vector<thread_cache *> spare_caches; // flushed after an eviction
+    const uint64_t id;
+
+    // Live pools of this type, so an evicted TLS entry can tell whether
+    // its pool still exists. Taken before a pool's own lock
+    struct pool_registry {
+        std::mutex lock;
+        std::vector<caching_pool *> live;
+    };
+
+    static pool_registry &registry() {
+        static pool_registry pools;
+        return pools;
+    }
+
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> ids{1};
+        return ids.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // This thread's (pool id -> cache) table, most recently used first
+    static tls_entry *tls() {
+        thread_local tls_entry entries[tls_entries] = {};
+        return entries;
+    }
+
+    thread_cache &local() {
+        tls_entry *entries = tls();
+        if (entries[0].id == id)
+            return *entries[0].cache;
+        return local_slow(entries);
+    }
+
+    thread_cache &local_slow(tls_entry *entries) {
+        tls_entry found{0, nullptr};
+        size_t at = tls_entries - 1; // evicted if we don't find ours
+        for (size_t i = 1; i < tls_entries; ++i)
+            if (entries[i].id == id) {
+                found = entries[i];
+                at = i;
+                break;
+            }
+        if (!found.cache) {
+            evict(entries[at]);
+            std::lock_guard<std::mutex> locker(lock);
+            if (!spare_caches.empty()) {
+                found = {id, spare_caches.back()};
+                spare_caches.pop_back();
+            } else {
+                caches.emplace_back(new thread_cache());
+                found = {id, caches.back().get()};
+            }
+        }
+        for (size_t i = at; i > 0; --i)
+            entries[i] = entries[i - 1];
+        entries[0] = found;
+        return *found.cache;
+    }
+
+    // Give the cache of an entry that drops out of the table back to its
+    // pool, unless that pool is gone (its caches went with it)
+    static void evict(const tls_entry &entry) {
+        if (!entry.cache)
+            return;
+        pool_registry &pools = registry();
+        std::lock_guard<std::mutex> locker(pools.lock);
+        for (caching_pool *pool : pools.live)
+            if (pool->id == entry.id) {
+                pool->retire(entry.cache);
+                return;
+            }
+    }
+
+    void retire(thread_cache *c) {
+        flush(c->mags[0]);
+        flush(c->mags[1]);
+        std::lock_guard<std::mutex> locker(lock);
+        spare_caches.push_back(c);
+    }
+
+    // Fill an empty magazine, depot first
+    void refill(magazine &m) {
+        std::lock_guard<std::mutex> locker(lock);
+        size_t from_depot = depot.size() < MagazineSize ? depot.size()
+                                                        : MagazineSize;
+        for (size_t i = 0; i < from_depot; ++i)
+            m.items[i] = depot[depot.size() - from_depot + i];
+        depot.resize(depot.size() - from_depot);
+        for (size_t i = from_depot; i < MagazineSize; ++i)
+            m.items[i] = backend.allocate();
+        m.count = MagazineSize;
+    }
+
+    // Empty a magazine into the depot, or the slabs once the depot is full
+    void flush(magazine &m) {
+        std::lock_guard<std::mutex> locker(lock);
+        for (size_t i = 0; i < m.count; ++i) {
+            if (depot.size() < depot_limit)
+                depot.push_back(m.items[i]);
+            else
+                backend.deallocate(m.items[i]);
+        }
+        m.count = 0;
+    }
+
+  public:
+    explicit caching_pool(size_t objects_per_slab = 1024,
+                          size_t depot_objects = 64 * MagazineSize)
+        : backend(objects_per_slab), depot_limit(depot_objects),
+          id(next_id()) {
+        depot.reserve(depot_limit);
+        pool_registry &pools = registry();
+        std::lock_guard<std::mutex> locker(pools.lock);
+        pools.live.push_back(this);
+    }
+
+    ~caching_pool() {
+        pool_registry &pools = registry();
+        std::lock_guard<std::mutex> locker(pools.lock);
+        for (size_t i = 0; i < pools.live.size(); ++i)
+            if (pools.live[i] == this) {
+                pools.live[i] = pools.live.back();
+                pools.live.pop_back();
+                break;
+            }
+    }
+
+    caching_pool(const caching_pool &) = delete;
+    caching_pool &operator=(const caching_pool &) = delete;
+
+    // Raw storage for one T
+    T *allocate() {
+        thread_cache &c = local();
+        if (c.loaded->count == 0) {
+            if (c.previous->count != 0)
+                std::swap(c.loaded, c.previous);
+            else
+                refill(*c.loaded);
+        }
+        return c.loaded->items[--c.loaded->count];
+    }
+
+    // Give a slot back, from any thread (no destructor runs)
+    void deallocate(T *p) {
+        thread_cache &c = local();
+        if (c.loaded->count == MagazineSize) {
+            if (c.previous->count != 0)
+                flush(*c.previous); // previous is full too
+            std::swap(c.loaded, c.previous);
+        }
+        c.loaded->items[c.loaded->count++] = p;
+    }
+
+    template <typename... Args> T *construct(Args &&...args) {
+        T *p = allocate();
+        try {
+            return new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy(T *p) {
+        p->~T();
+        deallocate(p);
+    }
+
+    // Hand this thread's cached objects back to the shared pool
+    void flush_thread_cache() {
+        thread_cache &c = local();
+        flush(*c.loaded);
+        flush(*c.previous);
+    }
+
+    // Objects taken out of the slabs (in use or sitting in caches/depot)
+    size_t slab_in_use() {
+        std::lock_guard<std::mutex> locker(lock);
+        return backend.in_use();
+    }
+
+    size_t depot_size() {
+        std::lock_guard<std::mutex> locker(lock);
+        return depot.size();
+    }
+};
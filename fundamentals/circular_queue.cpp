@@ -1,128 +1,15 @@
-#include "myiterator.hpp"
-#include <cstddef>
+#include "circular_queue.hpp"
+#include "market_data_tick.hpp"
+#include "multicast_cqueue.hpp"
+#include "shm_cqueue.hpp"
+#include "tracking_allocator.hpp"
+#include <atomic>
+#include <cstdint>
 #include <iostream>
-#include <new>       // for placement new
-#include <stdexcept> // for std::out_of_range
-#include <utility>   // for std::move
-
-template <typename T> struct cqueue {
-    T *data;
-    size_t size;
-    size_t capacity;
-    size_t start;
-    using iterator = myiterator<T>; // Define iterator type
-    using const_iterator =
-        myiterator<const T>; // Define iterator type for const
-    // Default constructor
-    cqueue() : data(nullptr), size(0), capacity(0), start(0) {}
-
-    // Copy constructor
-    cqueue(const cqueue &other)
-        : data(nullptr), size(0), capacity(0), start(0) {
-        if (other.size == 0)
-            return;
-
-        allocate(other.capacity);
-
-        // Copy elements in logical order
-        for (size_t i = 0; i < other.size; ++i) {
-            size_t idx = (other.start + i) % other.capacity;
-            new (data + i) T(other.data[idx]); // copy construct
-        }
-
-        size = other.size;
-        capacity = other.capacity;
-        start = 0; // reset to 0 in new buffer
-    }
-
-    // Allocate memory for obj elements
-    void allocate(size_t obj) {
-        data = static_cast<T *>(::operator new(obj * sizeof(T)));
-        capacity = obj;
-    }
-
-    // Deallocate memory
-    void deallocate(T *dataptr) { ::operator delete(dataptr); }
-
-    // Add to rear of queue
-    void cadd(const T &value) {
-        if (size == capacity) {
-            size_t new_capacity = (capacity == 0) ? 1 : capacity * 2;
-            T *new_data =
-                static_cast<T *>(::operator new(new_capacity * sizeof(T)));
-
-            // Move old elements to new buffer (in order)
-            for (size_t i = 0; i < size; ++i) {
-                size_t idx = (start + i) % capacity;
-                new (new_data + i) T(std::move(data[idx]));
-                data[idx].~T(); // destroy old
-            }
-
-            ::operator delete(data);
-            data = new_data;
-            capacity = new_capacity;
-            start = 0;
-        }
-
-        size_t idx = (start + size) % capacity;
-        new (data + idx) T(value); // placement new
-        ++size;
-    }
-
-    // Remove front
-    void cpop() {
-        if (size == 0)
-            return;
-        data[start].~T(); // destroy
-        start = (start + 1) % capacity;
-        --size;
-    }
-
-    // Access front
-    T &front() {
-        if (size == 0)
-            throw std::out_of_range("Queue is empty");
-        return data[start];
-    }
-
-    T &back() {
-        if (size == 0)
-            throw std::out_of_range("Queue is empty");
-        size_t idx = (start + size - 1) % capacity;
-        return data[idx];
-    }
-
-    // Queue is empty?
-    bool empty() const { return size == 0; }
-
-    // Number of elements
-    size_t length() const { return size; }
-
-    // Clear queue
-    void clear() {
-        for (size_t i = 0; i < size; ++i)
-            data[(start + i) % capacity].~T();
-        size = 0;
-        start = 0;
-    }
-    // begin(): returns iterator to first element
-    iterator begin() { return iterator(data); }
-
-    // end(): returns iterator to one-past-last element
-    iterator end() { return iterator(data + size); }
-
-    const_iterator begin() const { return const_iterator(data); }
-    const_iterator end() const { return const_iterator(data + size); }
-
-    // Destructor
-    ~cqueue() {
-        for (size_t i = 0; i < size; ++i) {
-            size_t idx = (start + i) % capacity;
-            data[idx].~T(); // proper destruction
-        }
-        deallocate(data);
-    }
-};
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
 
 int main() {
     std::cout << "===== BEGIN TEST CASES =====\n\n";
@@ -211,6 +98,263 @@ int main() {
     std::cout << "Expected Front: 3, Back: 5\nGot:      Front: " << q.front()
               << ", Back: " << q.back() << "\n\n";
 
+    // Test 12: SPSC Capacity Rounding
+    std::cout << "Test 12: SPSC Capacity Rounding\n";
+    spsc_cqueue<int> sq(5);
+    std::cout << "Expected: capacity = 8\nGot:      capacity = " << sq.capacity
+              << "\n\n";
+
+    // Test 13: SPSC Full / Empty and Mask Wrap-Around
+    std::cout << "Test 13: SPSC Full / Empty and Mask Wrap-Around\n";
+    int out = 0;
+    for (int i = 0; i < 6; ++i)
+        sq.try_cadd(i);
+    for (int i = 0; i < 6; ++i)
+        sq.try_cpop(out); // head and tail now at 6, next writes wrap
+    for (int i = 0; i < 8; ++i)
+        sq.try_cadd(100 + i);
+    bool full_rejected = !sq.try_cadd(999);
+    std::cout << "Expected: full rejected = 1, first = 100, last = 107\nGot:      "
+              << "full rejected = " << full_rejected;
+    sq.try_cpop(out);
+    std::cout << ", first = " << out;
+    while (sq.try_cpop(out)) {
+    }
+    std::cout << ", last = " << out << "\n\n";
+
+    // Test 14: SPSC Two-Thread Handoff Keeps Order
+    std::cout << "Test 14: SPSC Two-Thread Handoff Keeps Order\n";
+    const int handoff_count = 100000;
+    spsc_cqueue<int> pipe(64);
+    std::thread producer([&] {
+        for (int i = 0; i < handoff_count; ++i)
+            pipe.cadd(i);
+    });
+    bool in_order = true;
+    for (int i = 0; i < handoff_count; ++i) {
+        pipe.cpop(out);
+        in_order = in_order && (out == i);
+    }
+    producer.join();
+    std::cout << "Expected: in order = 1, empty = 1\nGot:      in order = "
+              << in_order << ", empty = " << pipe.empty() << "\n\n";
+
+    // Test 15: MPMC Try Variants
+    std::cout << "Test 15: MPMC Try Variants\n";
+    mpmc_cqueue<int> mq(4);
+    for (int i = 1; i <= 4; ++i)
+        mq.try_cadd(i);
+    bool mpmc_full_rejected = !mq.try_cadd(5);
+    mq.try_cpop(out);
+    std::cout << "Expected: full rejected = 1, front = 1\nGot:      "
+              << "full rejected = " << mpmc_full_rejected << ", front = " << out
+              << "\n\n";
+
+    // Test 16: MPMC Many Producers / Many Consumers
+    std::cout << "Test 16: MPMC Many Producers / Many Consumers\n";
+    const int per_producer = 50000;
+    mpmc_cqueue<long> shared(128);
+    std::atomic<long> consumed_sum{0};
+    std::vector<std::thread> workers;
+    for (int p = 0; p < 3; ++p)
+        workers.emplace_back([&] {
+            for (int i = 1; i <= per_producer; ++i)
+                shared.cadd((long)i);
+        });
+    for (int c = 0; c < 3; ++c)
+        workers.emplace_back([&] {
+            long v = 0, local = 0;
+            for (int i = 0; i < per_producer; ++i) {
+                shared.cpop(v);
+                local += v;
+            }
+            consumed_sum += local;
+        });
+    for (std::thread &w : workers)
+        w.join();
+    long expected_sum = 3L * per_producer * (per_producer + 1) / 2;
+    std::cout << "Expected: sum = " << expected_sum
+              << ", empty = 1\nGot:      sum = " << consumed_sum.load()
+              << ", empty = " << shared.empty() << "\n\n";
+
+    // Test 17: Bulk Add / Pop Across the Wrap Point
+    std::cout << "Test 17: Bulk Add / Pop Across the Wrap Point\n";
+    cqueue<int> bq;
+    int burst[6] = {1, 2, 3, 4, 5, 6};
+    int drained[8] = {};
+    bq.cadd_bulk(burst, 4); // capacity 4, full
+    bq.cpop_bulk(drained, 3);
+    bq.cadd_bulk(burst + 4, 2); // rear wraps to index 0
+    size_t popped = bq.cpop_bulk(drained, 8);
+    std::cout << "Expected: popped = 3, 4 5 6\nGot:      popped = " << popped
+              << ", " << drained[0] << " " << drained[1] << " " << drained[2]
+              << "\n\n";
+
+    // Test 18: Bulk Add / Pop With Non-Trivial Type
+    std::cout << "Test 18: Bulk Add / Pop With Non-Trivial Type\n";
+    cqueue<std::string> sq2;
+    std::string words[3] = {"bid", "ask", "last"};
+    sq2.cadd("tick");
+    sq2.cadd_bulk(words, 3); // forces a grow that must keep "tick" first
+    std::string got[4];
+    sq2.cpop_bulk(got, 4);
+    std::cout << "Expected: tick bid ask last, empty = 1\nGot:      " << got[0]
+              << " " << got[1] << " " << got[2] << " " << got[3]
+              << ", empty = " << sq2.empty() << "\n\n";
+
+    // Test 19: Overwrite-Oldest Keeps the Newest Entries
+    std::cout << "Test 19: Overwrite-Oldest Keeps the Newest Entries\n";
+    overwrite_cqueue<int> oq(4);
+    for (int i = 1; i <= 10; ++i)
+        oq.cadd(i);
+    std::cout << "Expected: 7 8 9 10, dropped = 6\nGot:      " << oq[0] << " "
+              << oq[1] << " " << oq[2] << " " << oq[3]
+              << ", dropped = " << oq.dropped << "\n\n";
+
+    // Test 20: Overwrite-Oldest Tick History With MDT
+    std::cout << "Test 20: Overwrite-Oldest Tick History With MDT\n";
+    overwrite_cqueue<MDT> history(3);
+    MDT tick{};
+    for (int i = 0; i < 5; ++i) {
+        tick.timestamp_ns = 1000 + i;
+        tick.last_price = 100.0 + i;
+        history.cadd(tick);
+    }
+    MDT oldest{};
+    history.cpop(oldest);
+    std::cout << "Expected: capacity = 4, oldest ts = 1001, newest price = 104"
+              << ", aligned = 1\nGot:      capacity = " << history.capacity
+              << ", oldest ts = " << oldest.timestamp_ns
+              << ", newest price = " << history.back().last_price
+              << ", aligned = "
+              << (reinterpret_cast<uintptr_t>(&history.data[0]) % alignof(MDT) == 0)
+              << "\n\n";
+
+    // Test 21: Iterator Follows Logical Order After Wrap-Around
+    std::cout << "Test 21: Iterator Follows Logical Order After Wrap-Around\n";
+    cqueue<int> wq;
+    for (int i = 1; i <= 4; ++i)
+        wq.cadd(i);
+    wq.cpop();
+    wq.cpop();
+    wq.cadd(5); // physical layout: 5 _ 3 4
+    std::cout << "Expected: 3 4 5, it[2] = 5, end - begin = 3\nGot:      ";
+    for (int x : wq)
+        std::cout << x << " ";
+    std::cout << ", it[2] = " << wq.begin()[2]
+              << ", end - begin = " << (wq.end() - wq.begin()) << "\n\n";
+
+    // Test 22: Contiguous Spans Over Wrapped Storage
+    std::cout << "Test 22: Contiguous Spans Over Wrapped Storage\n";
+    cspans<int> parts = wq.spans();
+    int span_sum = 0;
+    for (int x : parts.first)
+        span_sum += x;
+    for (int x : parts.second)
+        span_sum += x;
+    wq.cpop_n(parts.first.size());
+    std::cout << "Expected: first = 2, second = 1, sum = 12, front = 5\nGot:      "
+              << "first = " << parts.first.size()
+              << ", second = " << parts.second.size() << ", sum = " << span_sum
+              << ", front = " << wq.front() << "\n\n";
+
+    // Test 23: Shared-Memory Ring Through Two Separate Mappings
+    std::cout << "Test 23: Shared-Memory Ring Through Two Separate Mappings\n";
+    const std::string shm_name = "/circular_queue_test";
+    shm_cqueue<MDT> writer = shm_cqueue<MDT>::create(shm_name, 4);
+    shm_cqueue<MDT> viewer = shm_cqueue<MDT>::attach(shm_name);
+    shm_cqueue<MDT>::reader cursor = viewer.make_reader();
+    MDT published{};
+    for (int i = 0; i < 6; ++i) { // 6 into 4 slots, the first 2 are lost
+        published.timestamp_ns = 500 + i;
+        writer.publish(published);
+    }
+    MDT received{};
+    viewer.try_read(cursor, received);
+    std::cout << "Expected: readers = 1, different address = 1, first ts = "
+                 "502, dropped = 2\nGot:      readers = "
+              << writer.reader_count() << ", different address = "
+              << ((void *)writer.hdr != (void *)viewer.hdr)
+              << ", first ts = " << received.timestamp_ns
+              << ", dropped = " << cursor.dropped << "\n\n";
+    viewer.detach();
+    writer.detach();
+    shm_cqueue<MDT>::unlink(shm_name);
+
+    // Test 24: Multicast Ring, Every Stage Sees Every Item In Order
+    std::cout << "Test 24: Multicast Ring, Every Stage Sees Every Item In Order\n";
+    const int multicast_count = 100000;
+    multicast_cqueue<int, blocking_wait> fan(64);
+    auto &risk = fan.add_consumer();
+    auto &logger = fan.add_consumer();
+    auto &strategy = fan.add_consumer({&risk}); // only after risk is done
+    std::atomic<int> risk_done{0};
+    bool logger_ok = true, strategy_ok = true;
+    long stage_sum[3] = {0, 0, 0};
+    std::thread risk_thread([&] {
+        int seen = 0;
+        while (seen < multicast_count)
+            seen += fan.consume(risk, [&](const int &v) {
+                stage_sum[0] += v;
+                risk_done.store(v, std::memory_order_release);
+            });
+    });
+    std::thread logger_thread([&] {
+        int seen = 0, expect = 1;
+        while (seen < multicast_count)
+            seen += fan.consume(logger, [&](const int &v) {
+                stage_sum[1] += v;
+                logger_ok = logger_ok && (v == expect++);
+            });
+    });
+    std::thread strategy_thread([&] {
+        int seen = 0;
+        while (seen < multicast_count)
+            seen += fan.consume(strategy, [&](const int &v) {
+                stage_sum[2] += v;
+                strategy_ok = strategy_ok && (v <= risk_done.load());
+            });
+    });
+    for (int i = 1; i <= multicast_count; ++i)
+        fan.publish(i);
+    risk_thread.join();
+    logger_thread.join();
+    strategy_thread.join();
+    long multicast_sum = (long)multicast_count * (multicast_count + 1) / 2;
+    bool sums_equal =
+        stage_sum[1] == stage_sum[0] && stage_sum[2] == stage_sum[0];
+    std::cout << "Expected: all sums = " << multicast_sum
+              << ", ordered = 1\nGot:      "
+              << (sums_equal ? "all sums = " : "sums differ, first = ")
+              << stage_sum[0] << ", ordered = " << (logger_ok && strategy_ok)
+              << "\n\n";
+
+    // Test 25: cqueue On A Custom Allocator
+    std::cout << "Test 25: cqueue On A Custom Allocator\n";
+    cqueue<char, TrackingAllocator<char>> tq;
+    for (char c = 'a'; c < 'f'; ++c)
+        tq.cadd(c); // capacity 1 -> 2 -> 4 -> 8
+    tq.cpop();
+    tq.cpop();
+    cqueue<char, TrackingAllocator<char>> tq_copy(tq); // copies 3 into 8
+    cqueue<char, TrackingAllocator<char>> tq_moved(std::move(tq)); // no alloc
+    char arena_buf[1024];
+    std::pmr::monotonic_buffer_resource cq_arena(arena_buf, sizeof arena_buf);
+    pmr_cqueue<std::pmr::string> pq(&cq_arena);
+    pq.cadd("longer than the small string buffer");
+    std::cout << "Expected: cde cde, tracked = 23, in arena = 1 1\n"
+              << "Got:      ";
+    for (char c : tq_copy)
+        std::cout << c;
+    std::cout << " ";
+    for (char c : tq_moved)
+        std::cout << c;
+    std::cout << ", tracked = " << tq_moved.get_allocator().get_allocations()
+              << ", in arena = "
+              << (pq.get_allocator().resource() == &cq_arena) << " "
+              << (pq.front().get_allocator().resource() == &cq_arena)
+              << "\n\n";
+
     std::cout << "===== END TEST CASES =====\n";
 
     return 0;
@@ -0,0 +1,758 @@
+#pragma once
+#include <atomic>    // for the lock-free queue indices
+#include <cstddef>
+#include <cstdint>   // for intptr_t
+#include <cstring>   // for memcpy in the bulk paths
+#include <iostream>
+#include <memory>    // for std::allocator, allocator_traits
+#include <memory_resource> // for pmr_cqueue
+#include <new>       // for placement new
+#include <stdexcept> // for std::out_of_range
+#include <thread>    // for std::this_thread::yield
+#include <type_traits> // for std::is_trivially_copyable
+#include <utility>   // for std::move
+
+/*
+    Logical iterator over cqueue: position i is the i-th element from the
+    front, wherever it physically sits in the wrapped buffer. start < capacity
+    and i <= size <= capacity, so one conditional subtraction replaces the
+    modulo.
+*/
+template <typename I> struct cqueue_iterator {
+    I *data;
+    size_t capacity;
+    size_t start;
+    size_t i;
+
+    cqueue_iterator(I *d = nullptr, size_t cap = 0, size_t s = 0, size_t idx = 0)
+        : data(d), capacity(cap), start(s), i(idx) {}
+
+    I *slot(size_t logical) const {
+        size_t p = start + logical;
+        if (p >= capacity)
+            p -= capacity;
+        return data + p;
+    }
+
+    cqueue_iterator &operator++() {
+        ++i;
+        return *this;
+    }
+
+    cqueue_iterator &operator--() {
+        --i;
+        return *this;
+    }
+
+    cqueue_iterator operator++(int) {
+        cqueue_iterator original_value = *this;
+        ++i;
+        return original_value;
+    }
+
+    cqueue_iterator operator--(int) {
+        cqueue_iterator original_value = *this;
+        --i;
+        return original_value;
+    }
+
+    I &operator*() const { return *slot(i); }
+    I *operator->() const { return slot(i); }
+
+    bool operator==(const cqueue_iterator &other) const {
+        return i == other.i;
+    }
+
+    bool operator!=(const cqueue_iterator &other) const {
+        return !(i == other.i);
+    }
+
+    cqueue_iterator operator+(int n) const {
+        return cqueue_iterator(data, capacity, start, i + n);
+    }
+
+    cqueue_iterator operator-(int n) const {
+        return cqueue_iterator(data, capacity, start, i - n);
+    }
+
+    int operator-(const cqueue_iterator &other) const {
+        return (int)(i - other.i);
+    }
+
+    I &operator[](int index) const { return *slot(i + index); }
+};
+
+// Contiguous run of elements, like a minimal std::span
+template <typename I> struct cspan {
+    I *ptr;
+    size_t len;
+
+    I *begin() const { return ptr; }
+    I *end() const { return ptr + len; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+};
+
+// The queue contents in logical order: first, then second (empty unless the
+// contents wrap around the end of the buffer)
+template <typename I> struct cspans {
+    cspan<I> first;
+    cspan<I> second;
+};
+
+/*
+    Alloc works like myvector's: any standard allocator, elements are built
+    through allocator_traits and the propagate_on_container_* traits decide
+    whether the allocator follows the elements on copy, move and swap.
+*/
+template <typename T, typename Alloc = std::allocator<T>>
+struct cqueue : private Alloc { // empty allocators take no space
+    T *data;
+    size_t size;
+    size_t capacity;
+    size_t start;
+    using iterator = cqueue_iterator<T>; // Define iterator type
+    using const_iterator =
+        cqueue_iterator<const T>; // Define iterator type for const
+    using allocator_type = Alloc;
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    // Default constructor
+    cqueue() : data(nullptr), size(0), capacity(0), start(0) {}
+
+    explicit cqueue(const Alloc &alloc)
+        : Alloc(alloc), data(nullptr), size(0), capacity(0), start(0) {}
+
+    // Copy constructor
+    cqueue(const cqueue &other)
+        : cqueue(other, alloc_traits::select_on_container_copy_construction(
+                            other.get_allocator())) {}
+
+    cqueue(const cqueue &other, const Alloc &alloc) : cqueue(alloc) {
+        copy_from(other);
+    }
+
+    // Move constructor, takes the buffer and the allocator that owns it
+    cqueue(cqueue &&other) noexcept
+        : Alloc(std::move(other.get_allocator())), data(other.data),
+          size(other.size), capacity(other.capacity), start(other.start) {
+        other.data = nullptr;
+        other.size = other.capacity = other.start = 0;
+    }
+
+    // Move into a specific allocator, element-wise if it can't free
+    // other's buffer
+    cqueue(cqueue &&other, const Alloc &alloc) : cqueue(alloc) {
+        if (get_allocator() == other.get_allocator())
+            steal(other);
+        else
+            move_from(other);
+    }
+
+    cqueue &operator=(const cqueue &other) {
+        if (this == &other)
+            return *this;
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                          value) {
+            // our buffer has to go back to the allocator that made it
+            if (get_allocator() != other.get_allocator())
+                release();
+            get_allocator() = other.get_allocator();
+        }
+        copy_from(other);
+        return *this;
+    }
+
+    cqueue &operator=(cqueue &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) {
+        if (this == &other)
+            return *this;
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                          value) {
+            release();
+            get_allocator() = std::move(other.get_allocator());
+            steal(other);
+        } else if (get_allocator() == other.get_allocator()) {
+            release();
+            steal(other);
+        } else {
+            move_from(other);
+        }
+        return *this;
+    }
+
+    // Swapping buffers needs equal allocators unless they swap too
+    void swap(cqueue &other) noexcept {
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(get_allocator(), other.get_allocator());
+        }
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+        std::swap(start, other.start);
+    }
+
+    Alloc &get_allocator() { return *this; }
+    const Alloc &get_allocator() const { return *this; }
+
+    // Allocate memory for obj elements
+    void allocate(size_t obj) {
+        data = alloc_traits::allocate(get_allocator(), obj);
+        capacity = obj;
+    }
+
+    // Deallocate memory, obj is the capacity it was allocated with
+    void deallocate(T *dataptr, size_t obj) {
+        if (dataptr)
+            alloc_traits::deallocate(get_allocator(), dataptr, obj);
+    }
+
+    // Free the (empty) buffer
+    void release() {
+        deallocate(data, capacity);
+        data = nullptr;
+        capacity = 0;
+        start = 0;
+    }
+
+    // Take other's buffer, ours must already be released
+    void steal(cqueue &other) {
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+        start = other.start;
+        other.data = nullptr;
+        other.size = other.capacity = other.start = 0;
+    }
+
+    // Copy other's elements in logical order into our (empty) queue
+    void copy_from(const cqueue &other) {
+        if (other.size == 0)
+            return;
+        if (capacity < other.size)
+            grow(other.capacity);
+        size_t first = (other.size < other.capacity - other.start)
+                           ? other.size
+                           : other.capacity - other.start;
+        copy_into(data, other.data + other.start, first);
+        copy_into(data + first, other.data, other.size - first);
+        size = other.size;
+    }
+
+    // Same as copy_from but moves, and leaves other empty
+    void move_from(cqueue &other) {
+        if (capacity < other.size)
+            grow(other.capacity);
+        for (size_t i = 0; i < other.size; ++i)
+            construct(data + i,
+                      std::move(other.data[(other.start + i) % other.capacity]));
+        size = other.size;
+        other.clear();
+    }
+
+    template <typename... Args> void construct(T *p, Args &&...args) {
+        alloc_traits::construct(get_allocator(), p, std::forward<Args>(args)...);
+    }
+
+    void destroy(T *p) { alloc_traits::destroy(get_allocator(), p); }
+
+    // Move elements into a new buffer of new_capacity, unwrapped (start = 0)
+    void grow(size_t new_capacity) {
+        T *new_data = alloc_traits::allocate(get_allocator(), new_capacity);
+
+        // Old contents are at most two contiguous segments
+        size_t first = (size < capacity - start) ? size : capacity - start;
+        relocate(new_data, data + start, first);
+        relocate(new_data + first, data, size - first);
+
+        deallocate(data, capacity);
+        data = new_data;
+        capacity = new_capacity;
+        start = 0;
+    }
+
+    // Move-construct n elements from src into raw memory at dst and destroy
+    // the originals; trivially copyable types are a single memcpy
+    void relocate(T *dst, T *src, size_t n) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n)
+                std::memcpy(dst, src, n * sizeof(T));
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                construct(dst + i, std::move(src[i]));
+                destroy(src + i);
+            }
+        }
+    }
+
+    // Copy-construct n elements from src into raw memory at dst
+    void copy_into(T *dst, const T *src, size_t n) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n)
+                std::memcpy(dst, src, n * sizeof(T));
+        } else {
+            for (size_t i = 0; i < n; ++i)
+                construct(dst + i, src[i]);
+        }
+    }
+
+    // Add to rear of queue
+    void cadd(const T &value) {
+        if (size == capacity)
+            grow((capacity == 0) ? 1 : capacity * 2);
+
+        size_t idx = (start + size) % capacity;
+        construct(data + idx, value); // placement new via the allocator
+        ++size;
+    }
+
+    // Add n elements to rear of queue, grows at most once for the whole burst
+    void cadd_bulk(const T *src, size_t n) {
+        if (n == 0)
+            return;
+        if (size + n > capacity) {
+            size_t new_capacity = (capacity == 0) ? 1 : capacity;
+            while (new_capacity < size + n)
+                new_capacity *= 2;
+            grow(new_capacity);
+        }
+
+        // Free space starting at the rear is at most two contiguous segments
+        size_t rear = (start + size) % capacity;
+        size_t first = (n < capacity - rear) ? n : capacity - rear;
+        copy_into(data + rear, src, first);
+        copy_into(data, src + first, n - first);
+        size += n;
+    }
+
+    // Move up to n elements from the front into out (which must hold live
+    // objects), returns how many were popped
+    size_t cpop_bulk(T *out, size_t n) {
+        if (n > size)
+            n = size;
+        if (n == 0)
+            return 0;
+
+        size_t first = (n < capacity - start) ? n : capacity - start;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(out, data + start, first * sizeof(T));
+            std::memcpy(out + first, data, (n - first) * sizeof(T));
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                T &slot = data[(start + i) % capacity];
+                out[i] = std::move(slot);
+                destroy(&slot);
+            }
+        }
+        start = (start + n) % capacity;
+        size -= n;
+        return n;
+    }
+
+    // Remove front
+    void cpop() {
+        if (size == 0)
+            return;
+        destroy(data + start);
+        start = (start + 1) % capacity;
+        --size;
+    }
+
+    // Access front
+    T &front() {
+        if (size == 0)
+            throw std::out_of_range("Queue is empty");
+        return data[start];
+    }
+
+    T &back() {
+        if (size == 0)
+            throw std::out_of_range("Queue is empty");
+        size_t idx = (start + size - 1) % capacity;
+        return data[idx];
+    }
+
+    // Queue is empty?
+    bool empty() const { return size == 0; }
+
+    // Number of elements
+    size_t length() const { return size; }
+
+    // Clear queue
+    void clear() {
+        for (size_t i = 0; i < size; ++i)
+            destroy(data + (start + i) % capacity);
+        size = 0;
+        start = 0;
+    }
+    // begin(): returns iterator to first element
+    iterator begin() { return iterator(data, capacity, start, 0); }
+
+    // end(): returns iterator to one-past-last element
+    iterator end() { return iterator(data, capacity, start, size); }
+
+    const_iterator begin() const {
+        return const_iterator(data, capacity, start, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(data, capacity, start, size);
+    }
+
+    // Contents as at most two contiguous runs, front first. Valid until the
+    // next cadd/cpop/clear; lets batch consumers work on the buffer in place
+    cspans<T> spans() {
+        size_t first = (size < capacity - start) ? size : capacity - start;
+        return {{data + start, first}, {data, size - first}};
+    }
+
+    cspans<const T> spans() const {
+        size_t first = (size < capacity - start) ? size : capacity - start;
+        return {{data + start, first}, {data, size - first}};
+    }
+
+    // Drop n elements from the front after consuming them through spans()
+    void cpop_n(size_t n) {
+        if (n > size)
+            n = size;
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            if (n)
+                start = (start + n) % capacity;
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                destroy(data + start);
+                start = (start + 1 == capacity) ? 0 : start + 1;
+            }
+        }
+        size -= n;
+    }
+
+    // Destructor
+    ~cqueue() {
+        for (size_t i = 0; i < size; ++i) {
+            size_t idx = (start + i) % capacity;
+            destroy(data + idx); // proper destruction
+        }
+        deallocate(data, capacity);
+    }
+};
+
+// cqueue whose memory comes from a std::pmr::memory_resource
+template <typename T>
+using pmr_cqueue = cqueue<T, std::pmr::polymorphic_allocator<T>>;
+
+/*
+    Lock-free single-producer/single-consumer variant of cqueue.
+
+    - capacity is fixed at construction and rounded up to a power of two, so
+      the wrap is a mask (idx & mask) instead of % capacity
+    - head and tail are free-running counters (never wrapped), size is
+      tail - head
+    - the producer only writes tail and the consumer only writes head; each
+      lives on its own cache line so the two threads don't false-share
+    - each side keeps a cached copy of the other side's index and only
+      re-reads the shared atomic when the cached value says full/empty
+*/
+template <typename T> struct spsc_cqueue {
+    static constexpr size_t cache_line = 64;
+
+    // Read-only after construction, shared by both threads
+    alignas(cache_line) T *data;
+    size_t capacity;
+    size_t mask;
+
+    // Consumer side: next slot to read + last tail the consumer saw
+    alignas(cache_line) std::atomic<size_t> head;
+    size_t cached_tail;
+
+    // Producer side: next slot to write + last head the producer saw
+    alignas(cache_line) std::atomic<size_t> tail;
+    size_t cached_head;
+
+    explicit spsc_cqueue(size_t requested)
+        : data(nullptr), capacity(1), mask(0), head(0), cached_tail(0),
+          tail(0), cached_head(0) {
+        while (capacity < requested)
+            capacity <<= 1;
+        mask = capacity - 1;
+        data = static_cast<T *>(::operator new(capacity * sizeof(T),
+                                               std::align_val_t(alignof(T))));
+    }
+
+    // Slots hold live objects between push and pop, so no copying around
+    spsc_cqueue(const spsc_cqueue &) = delete;
+    spsc_cqueue &operator=(const spsc_cqueue &) = delete;
+
+    // Producer: add to rear, returns false if full
+    template <typename U> bool try_cadd(U &&value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cached_head == capacity) {
+            // Looks full, refresh our view of the consumer
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head == capacity)
+                return false;
+        }
+        new (data + (t & mask)) T(std::forward<U>(value));
+        tail.store(t + 1, std::memory_order_release); // publish the slot
+        return true;
+    }
+
+    // Consumer: move front into out and remove it, returns false if empty
+    bool try_cpop(T &out) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == cached_tail) {
+            // Looks empty, refresh our view of the producer
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail)
+                return false;
+        }
+        T &slot = data[h & mask];
+        out = std::move(slot);
+        slot.~T();
+        head.store(h + 1, std::memory_order_release); // hand the slot back
+        return true;
+    }
+
+    // Blocking variants: spin a little, then yield so a producer/consumer
+    // sharing the core can make progress
+    template <typename U> void cadd(U &&value) {
+        for (unsigned spins = 0; !try_cadd(std::forward<U>(value)); ++spins)
+            if (spins > 64)
+                std::this_thread::yield();
+    }
+
+    void cpop(T &out) {
+        for (unsigned spins = 0; !try_cpop(out); ++spins)
+            if (spins > 64)
+                std::this_thread::yield();
+    }
+
+    // Approximate when called while the other side is running
+    size_t length() const {
+        return tail.load(std::memory_order_acquire) -
+               head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return length() == 0; }
+
+    ~spsc_cqueue() {
+        // No other thread may touch the queue at this point
+        for (size_t i = head.load(); i != tail.load(); ++i)
+            data[i & mask].~T();
+        ::operator delete(data, std::align_val_t(alignof(T)));
+    }
+};
+
+/*
+    Bounded multi-producer/multi-consumer variant of cqueue (Vyukov style).
+
+    There is no global lock: every slot carries a sequence number that says
+    whose turn it is.
+    - seq == pos          slot is free for the producer that claims pos
+    - seq == pos + 1      slot holds the item for the consumer that claims pos
+    - after a pop the consumer sets seq = pos + capacity, i.e. free for the
+      producer one lap later
+    Producers race on enqueue_pos and consumers race on dequeue_pos with a
+    CAS, so contention is only between threads of the same side.
+*/
+template <typename T> struct mpmc_cqueue {
+    static constexpr size_t cache_line = 64;
+
+    struct cell {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *value() { return reinterpret_cast<T *>(storage); }
+    };
+
+    alignas(cache_line) cell *cells;
+    size_t capacity;
+    size_t mask;
+
+    alignas(cache_line) std::atomic<size_t> enqueue_pos;
+    alignas(cache_line) std::atomic<size_t> dequeue_pos;
+
+    explicit mpmc_cqueue(size_t requested)
+        : cells(nullptr), capacity(2), mask(0), enqueue_pos(0),
+          dequeue_pos(0) {
+        while (capacity < requested)
+            capacity <<= 1;
+        mask = capacity - 1;
+        cells = static_cast<cell *>(::operator new(
+            capacity * sizeof(cell), std::align_val_t(alignof(cell))));
+        for (size_t i = 0; i < capacity; ++i)
+            new (&cells[i].seq) std::atomic<size_t>(i);
+    }
+
+    mpmc_cqueue(const mpmc_cqueue &) = delete;
+    mpmc_cqueue &operator=(const mpmc_cqueue &) = delete;
+
+    // Add to rear, returns false if full
+    template <typename U> bool try_cadd(U &&value) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell &c = cells[pos & mask];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                // Slot is free for pos, try to claim it
+                if (enqueue_pos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    new (c.value()) T(std::forward<U>(value));
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS failure reloaded pos, retry
+            } else if (diff < 0) {
+                return false; // consumer of the previous lap hasn't left yet
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Move front into out and remove it, returns false if empty
+    bool try_cpop(T &out) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell &c = cells[pos & mask];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(*c.value());
+                    c.value()->~T();
+                    c.seq.store(pos + capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // producer for pos hasn't published yet
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Blocking variants: spin a little, then yield
+    template <typename U> void cadd(U &&value) {
+        for (unsigned spins = 0; !try_cadd(std::forward<U>(value)); ++spins)
+            if (spins > 64)
+                std::this_thread::yield();
+    }
+
+    void cpop(T &out) {
+        for (unsigned spins = 0; !try_cpop(out); ++spins)
+            if (spins > 64)
+                std::this_thread::yield();
+    }
+
+    // Approximate when called while other threads are running
+    size_t length() const {
+        size_t e = enqueue_pos.load(std::memory_order_acquire);
+        size_t d = dequeue_pos.load(std::memory_order_acquire);
+        return e > d ? e - d : 0;
+    }
+
+    bool empty() const { return length() == 0; }
+
+    ~mpmc_cqueue() {
+        // No other thread may touch the queue at this point
+        for (size_t pos = dequeue_pos.load(); pos != enqueue_pos.load(); ++pos)
+            cells[pos & mask].value()->~T();
+        ::operator delete(cells, std::align_val_t(alignof(cell)));
+    }
+};
+
+/*
+    Fixed-capacity conflating variant of cqueue for market data.
+
+    cqueue doubles when it is full; here a full queue overwrites its oldest
+    entry instead, so a slow consumer only ever loses history and never
+    stalls the writer. The only allocation happens in the constructor.
+    - capacity is rounded up to a power of two, wrap is idx & mask
+    - head/tail are free-running counters like spsc_cqueue, size is
+      tail - head
+    - dropped counts how many entries were overwritten before being read
+    Single-threaded, like cqueue.
+*/
+template <typename T> struct overwrite_cqueue {
+    T *data;
+    size_t capacity;
+    size_t mask;
+    size_t head;
+    size_t tail;
+    size_t dropped;
+
+    explicit overwrite_cqueue(size_t requested)
+        : data(nullptr), capacity(1), mask(0), head(0), tail(0), dropped(0) {
+        while (capacity < requested)
+            capacity <<= 1;
+        mask = capacity - 1;
+        // aligned new, so over-aligned T (MDT is alignas(64)) gets whole lines
+        data = static_cast<T *>(::operator new(capacity * sizeof(T),
+                                               std::align_val_t(alignof(T))));
+    }
+
+    overwrite_cqueue(const overwrite_cqueue &) = delete;
+    overwrite_cqueue &operator=(const overwrite_cqueue &) = delete;
+
+    // Add to rear, overwriting the oldest entry when full
+    void cadd(const T &value) {
+        if (tail - head == capacity) {
+            // Rear slot is the front slot, reuse the live object in place
+            data[tail & mask] = value;
+            ++head;
+            ++dropped;
+        } else {
+            new (data + (tail & mask)) T(value);
+        }
+        ++tail;
+    }
+
+    // Move front into out and remove it, returns false if empty
+    bool cpop(T &out) {
+        if (head == tail)
+            return false;
+        T &slot = data[head & mask];
+        out = std::move(slot);
+        slot.~T();
+        ++head;
+        return true;
+    }
+
+    T &front() {
+        if (head == tail)
+            throw std::out_of_range("Queue is empty");
+        return data[head & mask];
+    }
+
+    T &back() {
+        if (head == tail)
+            throw std::out_of_range("Queue is empty");
+        return data[(tail - 1) & mask];
+    }
+
+    // Logical index, 0 is the oldest entry still held
+    T &operator[](size_t index) { return data[(head + index) & mask]; }
+    const T &operator[](size_t index) const {
+        return data[(head + index) & mask];
+    }
+
+    bool empty() const { return head == tail; }
+    bool full() const { return tail - head == capacity; }
+    size_t length() const { return tail - head; }
+
+    void clear() {
+        for (; head != tail; ++head)
+            data[head & mask].~T();
+    }
+
+    ~overwrite_cqueue() {
+        clear();
+        ::operator delete(data, std::align_val_t(alignof(T)));
+    }
+};
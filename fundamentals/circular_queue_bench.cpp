@@ -0,0 +1,72 @@
+#include "circular_queue.hpp"
+#include "market_data_tick.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Burst throughput of cqueue: per-element cadd/cpop vs cadd_bulk/cpop_bulk.
+// Each round pushes a burst of MDT ticks and drains it again, the queue is
+// warmed up first so no round pays for growth.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+// Keeps the compiler from dropping the drained data
+volatile ull sink;
+
+double per_element(cqueue<MDT> &q, vector<MDT> &in, vector<MDT> &out,
+                   size_t burst, size_t rounds) {
+    auto start_time = steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < burst; ++i)
+            q.cadd(in[i]);
+        for (size_t i = 0; i < burst; ++i) {
+            out[i] = q.front();
+            q.cpop();
+        }
+        sink = out[burst - 1].timestamp_ns;
+    }
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)burst * rounds * 1e3 / dur.count(); // M elements/sec
+}
+
+double bulk(cqueue<MDT> &q, vector<MDT> &in, vector<MDT> &out, size_t burst,
+            size_t rounds) {
+    auto start_time = steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        q.cadd_bulk(in.data(), burst);
+        q.cpop_bulk(out.data(), burst);
+        sink = out[burst - 1].timestamp_ns;
+    }
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)burst * rounds * 1e3 / dur.count();
+}
+
+int main(int argc, char **argv) {
+    size_t total = (argc > 1) ? stoull(argv[1]) : 20000000; // elements per run
+
+    vector<MDT> in(4096), out(4096);
+    for (size_t i = 0; i < in.size(); ++i)
+        in[i].timestamp_ns = i;
+
+    cout << "sizeof(MDT) = " << sizeof(MDT) << ", elements per run = " << total
+         << "\n\n";
+    cout << "burst    per-element (M/s)    bulk (M/s)\n";
+    for (size_t burst = 1; burst <= 4096; burst *= 4) {
+        size_t rounds = total / burst;
+
+        // Leave the start offset odd so bursts straddle the wrap point
+        cqueue<MDT> q1, q2;
+        q1.cadd_bulk(in.data(), 4096);
+        q1.cpop_bulk(out.data(), 4095);
+        q2.cadd_bulk(in.data(), 4096);
+        q2.cpop_bulk(out.data(), 4095);
+
+        double a = per_element(q1, in, out, burst, rounds);
+        double b = bulk(q2, in, out, burst, rounds);
+        cout << burst << "\t " << a << "\t\t      " << b << "\n";
+    }
+    return 0;
+}
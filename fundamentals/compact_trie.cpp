@@ -0,0 +1,80 @@
+#include "compact_trie.hpp"
+#include "trie.hpp"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+int main() {
+    std::cout << "===== BEGIN TEST CASES =====\n\n";
+
+    compact_trie words;
+    words.insert("apple");
+    words.insert("apps");
+    words.insert("alien");
+
+    // Test 1: Same Answers As trie.cpp
+    std::cout << "Test 1: Same Answers As trie.cpp\n";
+    std::cout << "Expected: apple = 1, appe = 0, app = 0, prefix app = 1, "
+                 "prefix b = 0\nGot:      apple = "
+              << words.search("apple") << ", appe = " << words.search("appe")
+              << ", app = " << words.search("app")
+              << ", prefix app = " << words.starts_with("app")
+              << ", prefix b = " << words.starts_with("b") << "\n\n";
+
+    // Test 2: Duplicates And Bad Keys
+    std::cout << "Test 2: Duplicates And Bad Keys\n";
+    bool again = words.insert("apple");
+    bool threw = false;
+    try {
+        words.insert("apPle");
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    std::cout << "Expected: inserted again = 0, size = 3, threw = 1, "
+                 "prefix ap = 1\nGot:      inserted again = "
+              << again << ", size = " << words.size() << ", threw = " << threw
+              << ", prefix ap = " << words.starts_with("ap") << "\n\n";
+
+    // Test 3: Agrees With The Pointer Trie On Random Words
+    std::cout << "Test 3: Agrees With The Pointer Trie On Random Words\n";
+    std::mt19937 rng(7);
+    std::vector<std::string> keys(20000);
+    for (std::string &k : keys) {
+        k.resize(1 + rng() % 8);
+        for (char &ch : k)
+            ch = 'a' + rng() % 6; // small alphabet, lots of sharing
+    }
+    compact_trie compact;
+    trie *pointers = new trie();
+    for (size_t i = 0; i < keys.size() / 2; ++i) {
+        compact.insert(keys[i]);
+        insert(pointers, keys[i]);
+    }
+    size_t mismatches = 0;
+    for (const std::string &k : keys)
+        mismatches += compact.search(k) != search(pointers, k);
+    std::cout << "Expected: mismatches = 0, reused free slots = 1\nGot:      "
+              << "mismatches = " << mismatches << ", reused free slots = "
+              << (compact.free_bytes() < compact.memory_bytes() / 4) << "\n\n";
+
+    // Test 4: compact() Keeps Every Key And Drops The Free Lists
+    std::cout << "Test 4: compact() Keeps Every Key And Drops The Free Lists\n";
+    size_t before = compact.memory_bytes();
+    compact.compact();
+    mismatches = 0;
+    for (const std::string &k : keys)
+        mismatches += compact.search(k) != search(pointers, k);
+    size_t after = compact.memory_bytes(), free_after = compact.free_bytes();
+    compact.insert("fffffffff");
+    free_trie(pointers);
+    std::cout << "Expected: mismatches = 0, free = 0, smaller = 1, insert after "
+                 "= 1\nGot:      mismatches = "
+              << mismatches << ", free = " << free_after
+              << ", smaller = " << (after < before)
+              << ", insert after = " << compact.search("fffffffff") << "\n\n";
+
+    std::cout << "===== END TEST CASES =====\n";
+
+    return 0;
+}
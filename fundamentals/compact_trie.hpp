@@ -0,0 +1,176 @@
+#pragma once
+#include "myvector.hpp"
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t
+#include <stdexcept>   // for std::out_of_range
+#include <string_view>
+
+/*
+    Trie over 'a'..'z' keys (like trie in trie.hpp) with all nodes in one
+    pool of 32-bit slots and children found by index, not pointer.
+
+    - a node is a variable-size record in the pool: one header slot (bit c
+      set if there is a child for letter c, bit 31 if a key ends here)
+      followed by the indices of its children, packed in letter order. A
+      leaf is 4 bytes, a node with k children 4 + 4k, against 32 + 208
+      bytes and two allocations per trie node
+    - child c of node n is pool[n + 1 + popcount(bits below c)], so a
+      lookup is one header load, a popcount and one index load per letter,
+      usually within the same cache line
+    - giving a node another child means a record one slot longer: it is
+      copied to a new spot and its old slots go on a free list for that
+      record size, where the next record of that size picks them up
+    - slot 0 holds the root's index, so the root is re-linked like any
+      other child when it moves
+    - the pool is one myvector, freed as a whole with the trie; growing it
+      moves the slots but no index changes
+*/
+class compact_trie {
+    static constexpr uint32_t terminal = 1u << 31;
+    static constexpr uint32_t child_bits = (1u << 26) - 1;
+    static constexpr uint32_t none = 0; // no node, end of a free list
+    static constexpr size_t max_record = 1 + 26;
+
+    myvector<uint32_t> pool;
+    uint32_t free_records[max_record + 1] = {}; // by record size
+    size_t keys = 0;
+    size_t free_slots = 0;
+
+    static int letter(char ch) {
+        int c = ch - 'a';
+        return (c >= 0 && c < 26) ? c : -1;
+    }
+
+    static uint32_t rank(uint32_t header, int c) {
+        return __builtin_popcount(header & child_bits & ((1u << c) - 1));
+    }
+
+    uint32_t allocate_record(size_t slots) {
+        if (uint32_t at = free_records[slots]) {
+            free_records[slots] = pool.data[at];
+            free_slots -= slots;
+            return at;
+        }
+        size_t at = pool.size;
+        if (at + slots > UINT32_MAX)
+            throw std::out_of_range("compact_trie: pool exceeds 32-bit indices");
+        if (at + slots > pool.capacity)
+            pool.reserve(2 * pool.capacity > at + slots ? 2 * pool.capacity
+                                                        : at + slots);
+        pool.resize(at + slots);
+        return static_cast<uint32_t>(at);
+    }
+
+    void free_record(uint32_t at, size_t slots) {
+        pool.data[at] = free_records[slots];
+        free_records[slots] = at;
+        free_slots += slots;
+    }
+
+    // Node reached by walking key from the root, or none
+    uint32_t find(std::string_view key) const {
+        uint32_t node = pool.data[0];
+        for (char ch : key) {
+            int c = letter(ch);
+            uint32_t header = pool.data[node];
+            if (c < 0 || !(header & (1u << c)))
+                return none;
+            node = pool.data[node + 1 + rank(header, c)];
+        }
+        return node;
+    }
+
+    // Append node's record to out, then its subtrees depth-first
+    uint32_t copy_subtree(uint32_t node, myvector<uint32_t> &out) const {
+        uint32_t header = pool.data[node];
+        size_t children = __builtin_popcount(header & child_bits);
+        uint32_t at = static_cast<uint32_t>(out.size);
+        out.resize(at + 1 + children);
+        out.data[at] = header;
+        for (size_t i = 0; i < children; ++i) {
+            uint32_t child = copy_subtree(pool.data[node + 1 + i], out);
+            out.data[at + 1 + i] = child;
+        }
+        return at;
+    }
+
+  public:
+    compact_trie() {
+        pool.reserve(1024);
+        pool.resize(2);
+        pool.data[0] = 1; // root link -> empty root record at 1
+        pool.data[1] = 0;
+    }
+
+    // Add key; false if it was already there. Letters outside 'a'..'z'
+    // throw std::out_of_range before anything is added
+    bool insert(std::string_view key) {
+        for (char ch : key)
+            if (letter(ch) < 0)
+                throw std::out_of_range("compact_trie: key outside 'a'..'z'");
+        size_t link = 0; // slot that holds node's index
+        uint32_t node = pool.data[0];
+        for (char ch : key) {
+            int c = letter(ch);
+            uint32_t header = pool.data[node];
+            uint32_t r = rank(header, c);
+            if (header & (1u << c)) {
+                link = node + 1 + r;
+                node = pool.data[link];
+                continue;
+            }
+            uint32_t leaf = allocate_record(1);
+            pool.data[leaf] = 0;
+            size_t children = __builtin_popcount(header & child_bits);
+            uint32_t moved = allocate_record(children + 2);
+            uint32_t *from = pool.data + node; // pool may have moved above
+            uint32_t *to = pool.data + moved;
+            to[0] = header | (1u << c);
+            for (uint32_t i = 0; i < r; ++i)
+                to[1 + i] = from[1 + i];
+            to[1 + r] = leaf;
+            for (size_t i = r; i < children; ++i)
+                to[2 + i] = from[1 + i];
+            free_record(node, children + 1);
+            pool.data[link] = moved;
+            link = moved + 1 + r;
+            node = leaf;
+        }
+        if (pool.data[node] & terminal)
+            return false;
+        pool.data[node] |= terminal;
+        ++keys;
+        return true;
+    }
+
+    bool search(std::string_view key) const {
+        uint32_t node = find(key);
+        return node != none && (pool.data[node] & terminal);
+    }
+
+    // Some key starts with prefix
+    bool starts_with(std::string_view prefix) const {
+        return find(prefix) != none;
+    }
+
+    // Rewrite the pool in depth-first order without the free-listed slots:
+    // a key's path is then mostly forward in memory and small subtrees sit
+    // in one or two cache lines. Worth a call after a bulk load
+    void compact() {
+        myvector<uint32_t> packed;
+        packed.reserve(pool.size - free_slots); // no regrowth while copying
+        packed.resize(1);
+        uint32_t root = copy_subtree(pool.data[0], packed);
+        packed.data[0] = root;
+        pool = std::move(packed);
+        for (uint32_t &head : free_records)
+            head = none;
+        free_slots = 0;
+    }
+
+    size_t size() const { return keys; }
+
+    // Pool bytes reserved, and the part of it sitting on free lists
+    size_t memory_bytes() const { return pool.capacity * sizeof(uint32_t); }
+    size_t free_bytes() const { return free_slots * sizeof(uint32_t); }
+};
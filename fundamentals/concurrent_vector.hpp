@@ -0,0 +1,148 @@
+#pragma once
+#include <atomic>    // for the slot counter, bucket pointers and ready flags
+#include <cstddef>   // for size_t
+#include <new>       // for placement new, align_val_t
+#include <stdexcept> // for std::out_of_range
+#include <utility>   // for std::forward
+
+/*
+    Append-only vector for many writer threads, no lock.
+
+    - a writer claims its index with one fetch_add on claimed, then
+      constructs the element in place; nothing else is shared between
+      writers appending to different slots
+    - storage is a fixed table of buckets, bucket k holding 32 << k
+      elements, so index i maps to (bucket, offset) with a clz and a
+      subtraction. Buckets are allocated on first touch and published with
+      a CAS (a writer that loses the race frees its copy), and elements
+      never move, so references stay valid while others append
+    - each slot has a ready flag set with release after construction.
+      size() counts claimed slots, some of which may still be under
+      construction; a reader must see ready(i) (or get i from the writer
+      through some other synchronization) before reading element i
+    - if a constructor throws, its slot stays claimed but never ready
+*/
+template <typename T> struct concurrent_vector {
+    static constexpr size_t first_bucket_bits = 5;
+    static constexpr size_t first_bucket = size_t(1) << first_bucket_bits;
+    static constexpr size_t max_buckets = 64 - first_bucket_bits;
+
+    alignas(64) std::atomic<size_t> claimed;
+    alignas(64) std::atomic<T *> buckets[max_buckets];
+
+    concurrent_vector() : claimed(0) {
+        for (std::atomic<T *> &b : buckets)
+            b.store(nullptr, std::memory_order_relaxed);
+    }
+
+    concurrent_vector(const concurrent_vector &) = delete;
+    concurrent_vector &operator=(const concurrent_vector &) = delete;
+
+    static size_t bucket_size(size_t k) { return first_bucket << k; }
+
+    // Bucket holding element i, and i's offset inside it
+    static size_t locate(size_t i, size_t &offset) {
+        size_t pos = i + first_bucket;
+        size_t high_bit = 63 - __builtin_clzll(pos);
+        offset = pos - (size_t(1) << high_bit);
+        return high_bit - first_bucket_bits;
+    }
+
+    // A bucket is the elements followed by one ready flag per element
+    static std::atomic<bool> *flags(T *bucket, size_t k) {
+        return reinterpret_cast<std::atomic<bool> *>(
+            reinterpret_cast<char *>(bucket) + bucket_size(k) * sizeof(T));
+    }
+
+    static T *allocate_bucket(size_t k) {
+        size_t n = bucket_size(k);
+        T *bucket = static_cast<T *>(::operator new(
+            n * (sizeof(T) + sizeof(std::atomic<bool>)),
+            std::align_val_t(alignof(T))));
+        std::atomic<bool> *ready = flags(bucket, k);
+        for (size_t i = 0; i < n; ++i)
+            new (ready + i) std::atomic<bool>(false);
+        return bucket;
+    }
+
+    static void deallocate_bucket(T *bucket) {
+        ::operator delete(bucket, std::align_val_t(alignof(T)));
+    }
+
+    // Bucket k, allocating it if nobody has yet
+    T *bucket(size_t k) {
+        T *b = buckets[k].load(std::memory_order_acquire);
+        if (b)
+            return b;
+        T *fresh = allocate_bucket(k);
+        if (buckets[k].compare_exchange_strong(b, fresh,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire))
+            return fresh;
+        deallocate_bucket(fresh); // another writer got there first
+        return b;
+    }
+
+    // Construct a new element in place, returns its index
+    template <typename... Args> size_t emplace_back(Args &&...args) {
+        size_t i = claimed.fetch_add(1, std::memory_order_relaxed);
+        size_t offset;
+        size_t k = locate(i, offset);
+        T *b = bucket(k);
+        new (b + offset) T(std::forward<Args>(args)...);
+        flags(b, k)[offset].store(true, std::memory_order_release);
+        return i;
+    }
+
+    size_t mypush(const T &value) { return emplace_back(value); }
+    size_t mypush(T &&value) { return emplace_back(std::move(value)); }
+
+    // Slots claimed so far, including ones still being constructed
+    size_t size() const { return claimed.load(std::memory_order_acquire); }
+
+    // Element i is constructed and visible to this thread
+    bool ready(size_t i) const {
+        if (i >= size())
+            return false;
+        size_t offset;
+        size_t k = locate(i, offset);
+        T *b = buckets[k].load(std::memory_order_acquire);
+        return b && flags(b, k)[offset].load(std::memory_order_acquire);
+    }
+
+    // Unchecked access, i must be ready()
+    T &operator[](size_t i) {
+        size_t offset;
+        size_t k = locate(i, offset);
+        return buckets[k].load(std::memory_order_acquire)[offset];
+    }
+
+    const T &operator[](size_t i) const {
+        size_t offset;
+        size_t k = locate(i, offset);
+        return buckets[k].load(std::memory_order_acquire)[offset];
+    }
+
+    // Checked access
+    const T &at(size_t i) const {
+        if (!ready(i))
+            throw std::out_of_range("Element not published");
+        return (*this)[i];
+    }
+
+    // Not thread-safe: no writer may be running
+    ~concurrent_vector() {
+        size_t n = claimed.load(std::memory_order_acquire);
+        for (size_t k = 0; k < max_buckets; ++k) {
+            T *b = buckets[k].load(std::memory_order_acquire);
+            if (!b)
+                continue;
+            std::atomic<bool> *ready = flags(b, k);
+            size_t first = bucket_size(k) - first_bucket; // index of b[0]
+            for (size_t i = 0; i < bucket_size(k) && first + i < n; ++i)
+                if (ready[i].load(std::memory_order_relaxed))
+                    b[i].~T();
+            deallocate_bucket(b);
+        }
+    }
+};
@@ -1,30 +1,9 @@
-#include <cstdint> // For fixed-width integer types like uint64_t, uint32_t. These types ensure predictable memory layout, essential for performance-critical systems
+#include "market_data_tick.hpp"
+#include "circular_queue.hpp" // overwrite_cqueue for the bounded tick history
 #include <cstring> // For std::memcpy — used for fast, low-level memory copying. Often used in market data systems to copy raw bytes efficiently without constructors
 #include <immintrin.h> // For Intel SIMD intrinsics (e.g., _mm_prefetch). // Enables prefetching and vectorized processing — crucial for reducing latency
 #include <iostream>
 
-// Align to 64 bytes to avoid false sharing
-struct alignas(64) MDT { // alignas as aligns data with the cache line
-    uint64_t timestamp_ns;
-    double last_price;
-    double bid_price;
-    double ask_price;
-    uint32_t bid_size;
-    uint32_t ask_size;
-    char symbol[8]; // for layout predictability
-
-    uint8_t _pad[64 - (8 + (8 * 3) + (4 * 2) +
-                       8)]; // padding to align it to 64byte cache line exactly.
-    /*
-     8 -> uint64_t
-     8*3 -> double
-     4*2 -> uint32_t
-     8 -> char
-    */
-};
-
-static_assert(sizeof(MDT) == 64, "MDT should be exactly 64 bytes");
-
 void process_tick(const MDT &tick) {
     // prefetch next tick if streaming
     _mm_prefetch(reinterpret_cast<const char *>(&tick) + 64, _MM_HINT_T0);
@@ -51,5 +30,17 @@ int main() {
     // Process the tick (which prints it and prefetches the next one)
     process_tick(tick);
 
+    // Bounded-memory history: keep only the last 4 ticks for this symbol,
+    // older ones are overwritten and counted instead of growing the buffer
+    overwrite_cqueue<MDT> history(4);
+    for (int i = 0; i < 10; ++i) {
+        tick.timestamp_ns += 1000;
+        tick.last_price += 0.5;
+        history.cadd(tick);
+    }
+    std::cout << "History : " << history.length() << " ticks, "
+              << history.dropped << " dropped, oldest price "
+              << history.front().last_price << "\n";
+
     return 0;
 }
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint> // For fixed-width integer types like uint64_t, uint32_t. These types ensure predictable memory layout, essential for performance-critical systems
+
+// Align to 64 bytes to avoid false sharing
+struct alignas(64) MDT { // alignas as aligns data with the cache line
+    uint64_t timestamp_ns;
+    double last_price;
+    double bid_price;
+    double ask_price;
+    uint32_t bid_size;
+    uint32_t ask_size;
+    char symbol[8]; // for layout predictability
+
+    uint8_t _pad[64 - (8 + (8 * 3) + (4 * 2) +
+                       8)]; // padding to align it to 64byte cache line exactly.
+    /*
+     8 -> uint64_t
+     8*3 -> double
+     4*2 -> uint32_t
+     8 -> char
+    */
+};
+
+static_assert(sizeof(MDT) == 64, "MDT should be exactly 64 bytes");
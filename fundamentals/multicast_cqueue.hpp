@@ -0,0 +1,180 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory> // for std::unique_ptr
+#include <mutex>
+#include <thread> // for std::this_thread::yield
+#include <vector>
+
+/*
+    Wait strategies for multicast_cqueue. wait_until spins/sleeps until
+    ready() is true, notify is called by whoever made progress.
+*/
+
+// Lowest latency, burns a core per waiting thread
+struct busy_spin_wait {
+    template <typename Ready> void wait_until(Ready ready) {
+        while (!ready())
+            ;
+    }
+    void notify() {}
+};
+
+// Spin a little, then give the core away (like spsc_cqueue::cadd)
+struct yield_wait {
+    template <typename Ready> void wait_until(Ready ready) {
+        for (unsigned spins = 0; !ready(); ++spins)
+            if (spins > 64)
+                std::this_thread::yield();
+    }
+    void notify() {}
+};
+
+// Sleep on a condition_variable. notify only takes the lock when someone
+// is actually asleep, so a pipeline that keeps up pays one atomic load.
+struct blocking_wait {
+    std::mutex m;
+    std::condition_variable cv;
+    std::atomic<int> sleepers{0};
+
+    template <typename Ready> void wait_until(Ready ready) {
+        if (ready())
+            return;
+        std::unique_lock<std::mutex> locker(m);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv.wait(locker, ready);
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify() {
+        // Pairs with the fence in wait_until: either we see the sleeper or
+        // it sees the progress we just published
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) == 0)
+            return;
+        // Taking the lock orders us after a waiter that checked ready() and
+        // is about to sleep, so the wakeup can't be lost
+        { std::lock_guard<std::mutex> guard(m); }
+        cv.notify_all();
+    }
+};
+
+/*
+    Single-writer multicast ring (disruptor style).
+
+    Unlike spsc_cqueue/mpmc_cqueue, an item isn't consumed by one reader:
+    every consumer sees every item. Each consumer owns a cursor (how many
+    items it has finished) and the writer may only reuse a slot once every
+    consumer has moved past it.
+
+    - slots are constructed once up front and overwritten by assignment
+    - cursors are free-running counters on their own cache lines, the slot
+      is seq & mask
+    - a consumer added with dependencies only sees items that all of them
+      have finished (e.g. strategy after risk), otherwise it follows the
+      writer directly
+    - consumers process everything available in one batch and publish their
+      cursor once per batch
+
+    Add all consumers before starting any thread.
+*/
+template <typename T, typename Wait = yield_wait> struct multicast_cqueue {
+    static constexpr size_t cache_line = 64;
+
+    struct alignas(cache_line) sequence {
+        std::atomic<size_t> value{0};
+    };
+
+    struct consumer {
+        sequence cursor;
+        std::vector<const sequence *> barrier; // what we may not overtake
+        size_t cached_available = 0;
+
+        size_t min_barrier() const {
+            size_t m = barrier[0]->value.load(std::memory_order_acquire);
+            for (size_t i = 1; i < barrier.size(); ++i) {
+                size_t v = barrier[i]->value.load(std::memory_order_acquire);
+                if (v < m)
+                    m = v;
+            }
+            return m;
+        }
+    };
+
+    T *data;
+    size_t capacity;
+    size_t mask;
+
+    sequence published; // items the writer has made visible
+    size_t cached_gate; // writer's last view of the slowest consumer
+    std::vector<std::unique_ptr<consumer>> consumers;
+    Wait waiter;
+
+    explicit multicast_cqueue(size_t requested)
+        : data(nullptr), capacity(1), mask(0), cached_gate(0) {
+        while (capacity < requested)
+            capacity <<= 1;
+        mask = capacity - 1;
+        data = new T[capacity];
+    }
+
+    multicast_cqueue(const multicast_cqueue &) = delete;
+    multicast_cqueue &operator=(const multicast_cqueue &) = delete;
+
+    // New consumer that follows the writer, or the given upstream consumers
+    consumer &add_consumer(std::vector<consumer *> depends_on = {}) {
+        consumers.emplace_back(new consumer());
+        consumer &c = *consumers.back();
+        if (depends_on.empty())
+            c.barrier.push_back(&published);
+        for (consumer *up : depends_on)
+            c.barrier.push_back(&up->cursor);
+        return c;
+    }
+
+    size_t slowest_consumer() const {
+        size_t m = published.value.load(std::memory_order_relaxed);
+        for (const std::unique_ptr<consumer> &c : consumers) {
+            size_t v = c->cursor.value.load(std::memory_order_acquire);
+            if (v < m)
+                m = v;
+        }
+        return m;
+    }
+
+    // Writer: wait for the slowest consumer to free the slot, then publish
+    void publish(const T &value) {
+        size_t seq = published.value.load(std::memory_order_relaxed);
+        if (seq - cached_gate >= capacity) {
+            waiter.wait_until([&] {
+                cached_gate = slowest_consumer();
+                return seq - cached_gate < capacity;
+            });
+        }
+        data[seq & mask] = value;
+        published.value.store(seq + 1, std::memory_order_release);
+        waiter.notify();
+    }
+
+    // Consumer: wait for at least one item, then call f on every item
+    // currently available and release them all at once. Returns how many.
+    template <typename F> size_t consume(consumer &c, F f) {
+        size_t next = c.cursor.value.load(std::memory_order_relaxed);
+        if (next == c.cached_available) {
+            waiter.wait_until([&] {
+                c.cached_available = c.min_barrier();
+                return c.cached_available != next;
+            });
+        }
+        size_t end = c.cached_available;
+        for (size_t seq = next; seq != end; ++seq)
+            f(static_cast<const T &>(data[seq & mask]));
+        c.cursor.value.store(end, std::memory_order_release);
+        waiter.notify(); // writer or downstream consumers may be waiting
+        return end - next;
+    }
+
+    ~multicast_cqueue() { delete[] data; }
+};
@@ -1,3 +1,4 @@
+#pragma once
 template <typename I> struct myiterator {
     I *ptr;
 
@@ -0,0 +1,596 @@
+#pragma once
+#include <algorithm> // for std::make_heap/sort_heap, std::iter_swap
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for memcpy in radix_sort
+#include <functional> // for std::less
+#include <new>        // for align_val_t
+#include <thread>
+#include <type_traits>
+#include <utility> // for std::move, std::swap
+
+/*
+    Pattern-defeating quicksort (pdqsort) used by myvector::mysort.
+
+    It is an introsort with the extra tricks that matter for tick data:
+    - ranges of up to 24 elements go to insertion sort
+    - pivot is the median of three, or Tukey's ninther for big ranges
+    - if a partition didn't have to move anything the range was probably
+      already sorted, so both halves get a bounded insertion sort first;
+      sorted and reversed input finish in O(n)
+    - if the pivot equals the element just left of the range (which is
+      <= everything in it), everything equal to it is split off and
+      skipped, so few-unique input doesn't degrade
+    - a badly unbalanced split shuffles a few elements to break the
+      pattern, and after log2(n) of those we fall back to heapsort, so the
+      worst case stays O(n log n)
+    - we recurse into the smaller half and loop on the bigger one, so the
+      stack depth is O(log n)
+    - for arithmetic keys with std::less/std::greater the partition is
+      branchless: offsets of misplaced elements are collected in blocks
+      with conditional increments and swapped afterwards (BlockQuicksort),
+      which avoids the branch mispredictions of a classic partition
+*/
+
+constexpr ptrdiff_t sort_insertion_threshold = 24;
+constexpr ptrdiff_t sort_ninther_threshold = 128;
+constexpr ptrdiff_t sort_partial_insertion_limit = 8;
+constexpr ptrdiff_t sort_block_size = 64;
+
+// Branchless partitioning only pays off when comparing is cheap and free
+// of side effects
+template <typename T, typename Compare>
+struct sort_use_branchless
+    : std::integral_constant<
+          bool, std::is_arithmetic<T>::value &&
+                    (std::is_same<Compare, std::less<T>>::value ||
+                     std::is_same<Compare, std::greater<T>>::value ||
+                     std::is_same<Compare, std::less<>>::value ||
+                     std::is_same<Compare, std::greater<>>::value)> {};
+
+template <typename T, typename Compare>
+void sort_insertion(T *first, T *last, Compare comp) {
+    if (first == last)
+        return;
+    for (T *cur = first + 1; cur != last; ++cur) {
+        T *sift = cur;
+        T *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != first && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Insertion sort for a range whose left neighbour (*(first - 1)) is <= every
+// element, so the inner loop needs no bounds check
+template <typename T, typename Compare>
+void sort_unguarded_insertion(T *first, T *last, Compare comp) {
+    if (first == last)
+        return;
+    for (T *cur = first + 1; cur != last; ++cur) {
+        T *sift = cur;
+        T *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Like sort_insertion but gives up after moving sort_partial_insertion_limit
+// elements; returns true if the range ended up sorted
+template <typename T, typename Compare>
+bool sort_partial_insertion(T *first, T *last, Compare comp) {
+    if (first == last)
+        return true;
+    ptrdiff_t moves = 0;
+    for (T *cur = first + 1; cur != last; ++cur) {
+        T *sift = cur;
+        T *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != first && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            moves += cur - sift;
+        }
+        if (moves > sort_partial_insertion_limit)
+            return false;
+    }
+    return true;
+}
+
+template <typename T, typename Compare>
+void sort2(T *a, T *b, Compare comp) {
+    if (comp(*b, *a))
+        std::iter_swap(a, b);
+}
+
+// Leaves the median of *a, *b, *c in *b
+template <typename T, typename Compare>
+void sort3(T *a, T *b, T *c, Compare comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+// Moves the median of three or the ninther to *first
+template <typename T, typename Compare>
+void sort_choose_pivot(T *first, T *last, Compare comp) {
+    ptrdiff_t n = last - first;
+    ptrdiff_t s2 = n / 2;
+    if (n > sort_ninther_threshold) {
+        sort3(first, first + s2, last - 1, comp);
+        sort3(first + 1, first + (s2 - 1), last - 2, comp);
+        sort3(first + 2, first + (s2 + 1), last - 3, comp);
+        sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+        std::iter_swap(first, first + s2);
+    } else {
+        sort3(first + s2, first, last - 1, comp);
+    }
+}
+
+/*
+    Partitions [first, last) around the pivot in *first. Elements equal to
+    the pivot go right. Returns the pivot's final position; already_done is
+    set when nothing had to be swapped.
+*/
+template <typename T, typename Compare>
+T *sort_partition_right(T *first, T *last, Compare comp, bool &already_done) {
+    T pivot = std::move(*first);
+    T *lo = first;
+    T *hi = last;
+
+    // The median-of-3 guarantees an element >= pivot exists on the right
+    while (comp(*++lo, pivot))
+        ;
+    if (lo - 1 == first)
+        while (lo < hi && !comp(*--hi, pivot))
+            ;
+    else
+        while (!comp(*--hi, pivot))
+            ;
+
+    already_done = lo >= hi;
+    while (lo < hi) {
+        std::iter_swap(lo, hi);
+        while (comp(*++lo, pivot))
+            ;
+        while (!comp(*--hi, pivot))
+            ;
+    }
+
+    T *pivot_pos = lo - 1;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+// Same contract as sort_partition_right, but the swap decisions are made
+// without branches (see the header comment)
+template <typename T, typename Compare>
+T *sort_partition_right_branchless(T *first, T *last, Compare comp,
+                                   bool &already_done) {
+    T pivot = std::move(*first);
+    T *lo = first;
+    T *hi = last;
+
+    while (comp(*++lo, pivot))
+        ;
+    if (lo - 1 == first)
+        while (lo < hi && !comp(*--hi, pivot))
+            ;
+    else
+        while (!comp(*--hi, pivot))
+            ;
+
+    already_done = lo >= hi;
+    if (!already_done) {
+        // From here on [lo, hi) is unclassified, hi itself is >= pivot
+        std::iter_swap(lo, hi);
+        ++lo;
+
+        // Offsets of elements on the wrong side, relative to base_l/base_r
+        unsigned char offsets_l[sort_block_size];
+        unsigned char offsets_r[sort_block_size];
+        T *base_l = lo;
+        T *base_r = hi;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (lo < hi) {
+            // Refill whichever side ran out; near the end split the rest
+            size_t unknown = hi - lo;
+            size_t left_split =
+                num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+            size_t right_split = num_r == 0 ? unknown - left_split : 0;
+            if (left_split > (size_t)sort_block_size)
+                left_split = sort_block_size;
+            if (right_split > (size_t)sort_block_size)
+                right_split = sort_block_size;
+
+            // No branch on the comparison: always store the offset, only
+            // advance the count when the element is misplaced
+            for (size_t i = 0; i < left_split; ++i) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !comp(*lo, pivot);
+                ++lo;
+            }
+            for (size_t i = 0; i < right_split; ++i) {
+                offsets_r[num_r] = (unsigned char)(i + 1);
+                num_r += comp(*--hi, pivot);
+            }
+
+            size_t num = num_l < num_r ? num_l : num_r;
+            for (size_t i = 0; i < num; ++i)
+                std::iter_swap(base_l + offsets_l[start_l + i],
+                               base_r - offsets_r[start_r + i]);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                base_l = lo;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                base_r = hi;
+            }
+        }
+
+        // Everything is classified; at most one side has leftovers
+        if (num_l) {
+            while (num_l--)
+                std::iter_swap(base_l + offsets_l[start_l + num_l], --hi);
+            lo = hi;
+        }
+        if (num_r) {
+            while (num_r--) {
+                std::iter_swap(base_r - offsets_r[start_r + num_r], lo);
+                ++lo;
+            }
+        }
+    }
+
+    T *pivot_pos = lo - 1;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+// Partitions around *first putting elements equal to the pivot left, used
+// when the pivot equals our left neighbour. Returns the end of the equal run.
+template <typename T, typename Compare>
+T *sort_partition_left(T *first, T *last, Compare comp) {
+    T pivot = std::move(*first);
+    T *lo = first;
+    T *hi = last;
+
+    while (comp(pivot, *--hi))
+        ;
+    if (hi + 1 == last)
+        while (lo < hi && !comp(pivot, *++lo))
+            ;
+    else
+        while (!comp(pivot, *++lo))
+            ;
+
+    while (lo < hi) {
+        std::iter_swap(lo, hi);
+        while (comp(pivot, *--hi))
+            ;
+        while (!comp(pivot, *++lo))
+            ;
+    }
+
+    T *pivot_pos = hi;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+template <typename T, typename Compare, bool Branchless>
+void sort_pdq_loop(T *first, T *last, Compare comp, int bad_allowed,
+                   bool leftmost) {
+    for (;;) {
+        ptrdiff_t n = last - first;
+        if (n < sort_insertion_threshold) {
+            if (leftmost)
+                sort_insertion(first, last, comp);
+            else
+                sort_unguarded_insertion(first, last, comp);
+            return;
+        }
+
+        sort_choose_pivot(first, last, comp);
+
+        // Pivot equal to the left neighbour: skip the whole equal run
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = sort_partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        bool already_done;
+        T *pivot_pos =
+            Branchless
+                ? sort_partition_right_branchless(first, last, comp,
+                                                  already_done)
+                : sort_partition_right(first, last, comp, already_done);
+
+        ptrdiff_t l_size = pivot_pos - first;
+        ptrdiff_t r_size = last - (pivot_pos + 1);
+        bool highly_unbalanced = l_size < n / 8 || r_size < n / 8;
+
+        if (highly_unbalanced) {
+            if (--bad_allowed == 0) {
+                std::make_heap(first, last, comp);
+                std::sort_heap(first, last, comp);
+                return;
+            }
+            // Swap a few elements around to break the input pattern
+            if (l_size >= sort_insertion_threshold) {
+                std::iter_swap(first, first + l_size / 4);
+                std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+            }
+            if (r_size >= sort_insertion_threshold) {
+                std::iter_swap(pivot_pos + 1, pivot_pos + 1 + r_size / 4);
+                std::iter_swap(last - 1, last - r_size / 4);
+            }
+        } else if (already_done &&
+                   sort_partial_insertion(first, pivot_pos, comp) &&
+                   sort_partial_insertion(pivot_pos + 1, last, comp)) {
+            // Looked sorted and was: done
+            return;
+        }
+
+        // Recurse into the smaller side, loop on the bigger one
+        if (l_size < r_size) {
+            sort_pdq_loop<T, Compare, Branchless>(first, pivot_pos, comp,
+                                                  bad_allowed, leftmost);
+            first = pivot_pos + 1;
+            leftmost = false;
+        } else {
+            sort_pdq_loop<T, Compare, Branchless>(pivot_pos + 1, last, comp,
+                                                  bad_allowed, false);
+            last = pivot_pos;
+        }
+    }
+}
+
+inline int sort_log2(size_t n) {
+    int log = 0;
+    while (n >>= 1)
+        ++log;
+    return log;
+}
+
+template <typename T, typename Compare>
+void pdq_sort(T *first, T *last, Compare comp) {
+    if (last - first < 2)
+        return;
+    sort_pdq_loop<T, Compare, sort_use_branchless<T, Compare>::value>(
+        first, last, comp, sort_log2(last - first), true);
+}
+
+/*
+    Parallel mode: partition at the top, sort the two halves on two threads,
+    recursively until each thread has one range, then pdq_sort it. A bad
+    split (e.g. a range of mostly equal keys) stops splitting and lets
+    pdq_sort deal with it on the current thread.
+*/
+constexpr ptrdiff_t sort_parallel_cutoff = 1 << 16;
+
+template <typename T, typename Compare>
+void parallel_sort(T *first, T *last, Compare comp, unsigned threads) {
+    ptrdiff_t n = last - first;
+    if (threads <= 1 || n < sort_parallel_cutoff) {
+        pdq_sort(first, last, comp);
+        return;
+    }
+
+    sort_choose_pivot(first, last, comp);
+    bool already_done;
+    T *pivot_pos = sort_use_branchless<T, Compare>::value
+                       ? sort_partition_right_branchless(first, last, comp,
+                                                         already_done)
+                       : sort_partition_right(first, last, comp,
+                                              already_done);
+    ptrdiff_t l_size = pivot_pos - first;
+    ptrdiff_t r_size = last - (pivot_pos + 1);
+    if (l_size < n / 8 || r_size < n / 8) {
+        pdq_sort(first, pivot_pos, comp);
+        pdq_sort(pivot_pos + 1, last, comp);
+        return;
+    }
+
+    unsigned left_threads = threads / 2;
+    std::thread left([=] {
+        parallel_sort(first, pivot_pos, comp, left_threads);
+    });
+    parallel_sort(pivot_pos + 1, last, comp, threads - left_threads);
+    left.join();
+}
+
+/*
+    LSD radix sort, used by myvector::mysort for integral and floating-point
+    elements and by mysort_by_key for records with such a key.
+
+    - keys are mapped to unsigned integers that order the same way: signed
+      ints get their sign bit flipped, floats get all bits flipped when
+      negative and only the sign bit flipped otherwise
+    - one 8-bit digit per pass, sizeof(key) passes; all histograms come
+      from a single read of the input
+    - a pass is skipped when every key has the same byte there (e.g. the
+      high bytes of timestamps from one session), so narrow key ranges
+      cost fewer passes
+    - elements ping-pong between the data and a scratch buffer that is kept
+      per thread and reused by later sorts (radix_release_scratch frees it)
+*/
+constexpr ptrdiff_t radix_min_size = 256; // below this pdq_sort wins
+
+template <typename T>
+struct radix_sortable
+    : std::integral_constant<bool, ((std::is_integral<T>::value &&
+                                     !std::is_same<T, bool>::value) ||
+                                    std::is_floating_point<T>::value) &&
+                                       sizeof(T) <= 8> {};
+
+template <size_t Bytes> struct radix_unsigned;
+template <> struct radix_unsigned<1> { using type = uint8_t; };
+template <> struct radix_unsigned<2> { using type = uint16_t; };
+template <> struct radix_unsigned<4> { using type = uint32_t; };
+template <> struct radix_unsigned<8> { using type = uint64_t; };
+
+// Order-preserving map from K to an unsigned integer of the same size
+template <typename K>
+typename radix_unsigned<sizeof(K)>::type radix_key_bits(K key) {
+    using U = typename radix_unsigned<sizeof(K)>::type;
+    constexpr U sign = U(1) << (sizeof(K) * 8 - 1);
+    U u;
+    std::memcpy(&u, &key, sizeof(K));
+    if constexpr (std::is_floating_point<K>::value)
+        u ^= (u & sign) ? U(~U(0)) : sign;
+    else if constexpr (std::is_signed<K>::value)
+        u ^= sign;
+    return u;
+}
+
+// Per-thread scratch memory, grown on demand and kept between sorts
+struct radix_scratch {
+    void *ptr = nullptr;
+    size_t bytes = 0;
+
+    void *get(size_t need) {
+        if (need > bytes) {
+            release();
+            ptr = ::operator new(need, std::align_val_t(64));
+            bytes = need;
+        }
+        return ptr;
+    }
+
+    void release() {
+        if (ptr)
+            ::operator delete(ptr, std::align_val_t(64));
+        ptr = nullptr;
+        bytes = 0;
+    }
+
+    ~radix_scratch() { release(); }
+};
+
+inline radix_scratch &radix_thread_scratch() {
+    thread_local radix_scratch scratch;
+    return scratch;
+}
+
+inline void radix_release_scratch() { radix_thread_scratch().release(); }
+
+/*
+    The passes themselves: items move between src and dst by the byte of
+    bits(item) selected for each pass. counts holds every pass's histogram.
+    Returns where the result ended up (data or scratch).
+*/
+template <typename Item, typename U, typename BitsFn>
+Item *radix_passes(Item *data, Item *scratch, size_t n, BitsFn bits,
+                   size_t (*counts)[256], bool descending) {
+    Item *src = data;
+    Item *dst = scratch;
+    for (size_t p = 0; p < sizeof(U); ++p) {
+        size_t *count = counts[p];
+        if (count[(bits(src[0]) >> (8 * p)) & 0xff] == n)
+            continue; // every key has the same byte here
+
+        // Bucket start offsets, walked backwards for descending order
+        size_t offset[256];
+        size_t sum = 0;
+        if (descending)
+            for (int b = 255; b >= 0; --b) {
+                offset[b] = sum;
+                sum += count[b];
+            }
+        else
+            for (int b = 0; b < 256; ++b) {
+                offset[b] = sum;
+                sum += count[b];
+            }
+
+        for (size_t i = 0; i < n; ++i) {
+            Item *to = dst + offset[(bits(src[i]) >> (8 * p)) & 0xff]++;
+            std::memcpy(static_cast<void *>(to), &src[i], sizeof(Item));
+        }
+        Item *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    return src;
+}
+
+/*
+    Sorts trivially copyable records by key(record); stable.
+
+    Small records move through the passes themselves. Records much bigger
+    than their key (MDT is 64 bytes for an 8-byte timestamp) would drag the
+    whole record through every pass, so instead (key bits, index) pairs are
+    sorted and the records are gathered into place once at the end.
+*/
+template <typename T, typename KeyFn>
+void radix_sort(T *data, size_t n, KeyFn key, bool descending = false) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "radix_sort moves elements as raw bytes");
+    static_assert(alignof(T) <= 64, "the radix scratch is 64-byte aligned");
+    using K = std::decay_t<decltype(key(*data))>;
+    using U = typename radix_unsigned<sizeof(K)>::type;
+    if (n < 2)
+        return;
+
+    // All histograms in one read of the input
+    size_t counts[sizeof(U)][256] = {};
+    for (size_t i = 0; i < n; ++i) {
+        U u = radix_key_bits(key(data[i]));
+        for (size_t p = 0; p < sizeof(U); ++p)
+            ++counts[p][(u >> (8 * p)) & 0xff];
+    }
+
+    struct keyed {
+        U bits;
+        size_t index;
+    };
+    if constexpr (sizeof(T) > 2 * sizeof(keyed)) {
+        // gathered starts after the pairs, rounded up so it is a real T
+        // array (n odd leaves 2 * n * 16 bytes only 32-byte aligned)
+        size_t gathered_at =
+            (2 * n * sizeof(keyed) + alignof(T) - 1) / alignof(T) * alignof(T);
+        char *mem = static_cast<char *>(
+            radix_thread_scratch().get(gathered_at + n * sizeof(T)));
+        keyed *pairs = reinterpret_cast<keyed *>(mem);
+        keyed *pair_scratch = pairs + n;
+        T *gathered = reinterpret_cast<T *>(mem + gathered_at);
+        for (size_t i = 0; i < n; ++i)
+            pairs[i] = {radix_key_bits(key(data[i])), i};
+
+        keyed *sorted = radix_passes<keyed, U>(
+            pairs, pair_scratch, n, [](const keyed &k) { return k.bits; },
+            counts, descending);
+        for (size_t i = 0; i < n; ++i)
+            std::memcpy(static_cast<void *>(&gathered[i]),
+                        &data[sorted[i].index], sizeof(T));
+        std::memcpy(static_cast<void *>(data), gathered, n * sizeof(T));
+    } else {
+        T *scratch = static_cast<T *>(radix_thread_scratch().get(n * sizeof(T)));
+        T *sorted = radix_passes<T, U>(
+            data, scratch, n,
+            [&](const T &v) { return radix_key_bits(key(v)); }, counts,
+            descending);
+        if (sorted != data)
+            std::memcpy(static_cast<void *>(data), sorted, n * sizeof(T));
+    }
+}
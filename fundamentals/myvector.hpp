@@ -0,0 +1,409 @@
+#pragma once
+#include "myiterator.hpp"
+#include "mysort.hpp"
+#include <cstddef>  // for size_t, max_align_t
+#include <cstdlib>  // for malloc/realloc/free
+#include <cstring>  // for memcpy
+#include <functional> // for std::less/std::greater
+#include <iostream> // optional, for debugging
+#include <memory>   // for std::allocator, allocator_traits
+#include <memory_resource> // for pmr_myvector
+#include <new>      // for placement new, align_val_t, bad_alloc
+#include <thread>   // for hardware_concurrency
+#include <type_traits>
+#include <utility> // for std::move, std::swap
+
+/*
+    True if a T can be moved to a new address with memcpy and the old bytes
+    simply forgotten (no move constructor + destructor pair needed).
+    Trivially copyable types always qualify; specialize it for types that
+    own resources but don't point into themselves.
+*/
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/*
+    True if Alloc can change the size of an allocation without moving it
+    (bool resize_in_place(T *p, size_t old_n, size_t new_n), e.g.
+    vm_allocator); myvector then grows by asking for that first.
+*/
+template <typename Alloc, typename = void>
+struct has_resize_in_place : std::false_type {};
+
+template <typename Alloc>
+struct has_resize_in_place<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().resize_in_place(
+               std::declval<typename Alloc::value_type *>(), size_t(),
+               size_t()))>> : std::true_type {};
+
+/*
+    Alloc is any standard allocator (std::allocator by default,
+    TrackingAllocator, std::pmr::polymorphic_allocator for pmr_myvector...).
+    Elements are constructed and destroyed through allocator_traits, so a
+    pmr allocator is also handed down to pmr-aware elements, and the
+    propagate_on_container_* traits decide whether the allocator follows
+    the elements on copy, move and swap.
+*/
+template <typename T, typename Alloc = std::allocator<T>>
+struct myvector : private Alloc { // empty allocators take no space
+    T *data;         // Pointer to dynamically allocated array of T
+    size_t size;     // Number of elements currently used
+    size_t capacity; // Total allocated slots (not necessarily filled)
+    using iterator = myiterator<T>; // Define iterator type
+    using const_iterator =
+        myiterator<const T>; // Define iterator type for const
+    using allocator_type = Alloc;
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    // Default constructor
+    myvector() : data(nullptr), size(0), capacity(0) {}
+
+    explicit myvector(const Alloc &alloc)
+        : Alloc(alloc), data(nullptr), size(0), capacity(0) {}
+
+    // Copy constructor, the allocator decides what the copy gets
+    myvector(const myvector &other)
+        : myvector(other, alloc_traits::select_on_container_copy_construction(
+                              other.get_allocator())) {}
+
+    myvector(const myvector &other, const Alloc &alloc) : myvector(alloc) {
+        reserve(other.size);
+        for (; size < other.size; ++size)
+            construct(data + size, other.data[size]);
+    }
+
+    // Move constructor, takes the buffer and the allocator that owns it
+    myvector(myvector &&other) noexcept
+        : Alloc(std::move(other.get_allocator())), data(other.data),
+          size(other.size), capacity(other.capacity) {
+        other.data = nullptr;
+        other.size = other.capacity = 0;
+    }
+
+    // Move into a specific allocator, element-wise if it can't free
+    // other's buffer
+    myvector(myvector &&other, const Alloc &alloc) : myvector(alloc) {
+        if (get_allocator() == other.get_allocator()) {
+            steal(other);
+        } else {
+            reserve(other.size);
+            for (; size < other.size; ++size)
+                construct(data + size, std::move(other.data[size]));
+            other.clear();
+        }
+    }
+
+    // Template copy constructor to allow conversion like myvector<int> to
+    // myvector<double>, etc.
+    template <typename U> myvector(const myvector<U> &other) {}
+
+    myvector &operator=(const myvector &other) {
+        if (this == &other)
+            return *this;
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                          value) {
+            // our buffer has to go back to the allocator that made it
+            if (get_allocator() != other.get_allocator())
+                release();
+            get_allocator() = other.get_allocator();
+        }
+        reserve(other.size);
+        for (; size < other.size; ++size)
+            construct(data + size, other.data[size]);
+        return *this;
+    }
+
+    myvector &operator=(myvector &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) {
+        if (this == &other)
+            return *this;
+        clear();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                          value) {
+            release();
+            get_allocator() = std::move(other.get_allocator());
+            steal(other);
+        } else if (get_allocator() == other.get_allocator()) {
+            release();
+            steal(other);
+        } else {
+            // different arenas: other's buffer isn't ours to keep
+            reserve(other.size);
+            for (; size < other.size; ++size)
+                construct(data + size, std::move(other.data[size]));
+            other.clear();
+        }
+        return *this;
+    }
+
+    // Swapping buffers needs equal allocators unless they swap too
+    void swap(myvector &other) noexcept {
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(get_allocator(), other.get_allocator());
+        }
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        std::swap(capacity, other.capacity);
+    }
+
+    Alloc &get_allocator() { return *this; }
+    const Alloc &get_allocator() const { return *this; }
+
+    /*
+        Growth strategy, picked at compile time:
+        - trivially copyable, normally aligned T with the default allocator:
+          buffer comes from malloc and grows with realloc, which can often
+          extend in place and otherwise copies the bytes for us
+        - other trivially relocatable T (e.g. over-aligned MDT, or any
+          trivially copyable T on a custom allocator): new buffer + one
+          memcpy, no per-element move/destroy
+        - everything else (e.g. std::string): move-construct each element
+          into the new buffer and destroy the old one
+        Before any of these, an allocator that can resize in place gets
+        asked to, so nothing moves at all.
+    */
+    static constexpr bool use_realloc =
+        std::is_same_v<Alloc, std::allocator<T>> &&
+        std::is_trivially_copyable_v<T> &&
+        alignof(T) <= alignof(std::max_align_t);
+
+    // Allocate memory (std::allocator handles over-aligned T itself)
+    T *allocate(size_t obj) {
+        if constexpr (use_realloc)
+            return static_cast<T *>(std::malloc(obj * sizeof(T)));
+        else
+            return alloc_traits::allocate(get_allocator(), obj);
+    }
+
+    // Deallocate memory, obj is the capacity it was allocated with
+    void deallocate(T *dataptr, size_t obj) {
+        if constexpr (use_realloc)
+            std::free(dataptr);
+        else if (dataptr)
+            alloc_traits::deallocate(get_allocator(), dataptr, obj);
+    }
+
+    template <typename... Args> void construct(T *p, Args &&...args) {
+        alloc_traits::construct(get_allocator(), p, std::forward<Args>(args)...);
+    }
+
+    void destroy(T *p) { alloc_traits::destroy(get_allocator(), p); }
+
+    // Move the elements into a buffer of exactly new_capacity (>= size)
+    void reallocate(size_t new_capacity) {
+        if constexpr (has_resize_in_place<Alloc>::value) {
+            if (data && get_allocator().resize_in_place(data, capacity,
+                                                        new_capacity)) {
+                capacity = new_capacity;
+                return;
+            }
+        }
+        if constexpr (use_realloc) {
+            T *new_data =
+                static_cast<T *>(std::realloc(data, new_capacity * sizeof(T)));
+            if (!new_data)
+                throw std::bad_alloc();
+            data = new_data;
+        } else {
+            T *new_data = allocate(new_capacity);
+            if constexpr (is_trivially_relocatable<T>::value) {
+                if (size)
+                    std::memcpy(static_cast<void *>(new_data), data,
+                                size * sizeof(T));
+            } else {
+                for (size_t i = 0; i < size; ++i) {
+                    // move-construct at new_data + i, then destroy the old
+                    construct(new_data + i, std::move(data[i]));
+                    destroy(data + i);
+                }
+            }
+            deallocate(data, capacity);
+            data = new_data;
+        }
+        capacity = new_capacity;
+    }
+
+    // Free the (empty) buffer
+    void release() {
+        deallocate(data, capacity);
+        data = nullptr;
+        capacity = 0;
+    }
+
+    // Take other's buffer, ours must already be released
+    void steal(myvector &other) {
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+        other.data = nullptr;
+        other.size = other.capacity = 0;
+    }
+
+    // Make room for at least n elements without changing size
+    void reserve(size_t n) {
+        if (n > capacity)
+            reallocate(n);
+    }
+
+    // Give back unused capacity
+    void shrink_to_fit() {
+        if (size == capacity)
+            return;
+        if (size == 0) {
+            release();
+            return;
+        }
+        reallocate(size);
+    }
+
+    // Construct a new last element in place from args
+    template <typename... Args> T &emplace_back(Args &&...args) {
+        if (size == capacity) {
+            // args may refer to one of our own elements, so build the value
+            // before the old buffer goes away
+            T tmp(std::forward<Args>(args)...);
+            reallocate((capacity == 0) ? 1 : capacity * 2);
+            construct(data + size, std::move(tmp));
+        } else {
+            construct(data + size, std::forward<Args>(args)...);
+        }
+        return data[size++];
+    }
+
+    void mypush(const T &value) { emplace_back(value); }
+    void mypush(T &&value) { emplace_back(std::move(value)); }
+
+    // Grow with default-constructed elements or shrink by destroying
+    void resize(size_t n) {
+        reserve(n);
+        for (; size < n; ++size)
+            construct(data + size);
+        while (size > n)
+            destroy(data + --size);
+    }
+
+    void resize(size_t n, const T &value) {
+        if (n > capacity) {
+            T tmp(value); // value may live in our buffer
+            reserve(n);
+            for (; size < n; ++size)
+                construct(data + size, tmp);
+        }
+        for (; size < n; ++size)
+            construct(data + size, value);
+        while (size > n)
+            destroy(data + --size);
+    }
+
+    // Pop the last element
+    void mypop() {
+        if (size == 0)
+            return; // avoid underflow
+
+        // Call destructor for last element
+        destroy(data + size - 1);
+        --size;
+    }
+
+    // General index access
+
+    // for non constant objects (can modify elements)
+    T &operator[](size_t index) { return data[index]; }
+
+    // for constant objects (read only access)
+    const T &operator[](size_t index) const { return data[index]; }
+
+    // for printing the vector
+    void myprint() {
+        for (size_t i = 0; i < size; ++i) {
+            std::cout << data[i] << " ";
+        }
+    }
+
+    // Integral and floating-point elements use LSD radix sort, everything
+    // else pdqsort (introsort with pattern detection), see mysort.hpp
+    void mysort(bool descending = false) {
+        if constexpr (radix_sortable<T>::value) {
+            if ((ptrdiff_t)size >= radix_min_size) {
+                radix_sort(data, size, [](const T &v) { return v; },
+                           descending);
+                return;
+            }
+        }
+        if (descending)
+            pdq_sort(data, data + size, std::greater<T>());
+        else
+            pdq_sort(data, data + size, std::less<T>());
+    }
+
+    // Sort records by key, e.g.
+    // ticks.mysort_by_key([](const MDT &t) { return t.timestamp_ns; });
+    // Stable at every size: radix sort when T can be moved as raw bytes and
+    // the key is integral or floating-point, std::stable_sort otherwise
+    template <typename KeyFn>
+    void mysort_by_key(KeyFn key, bool descending = false) {
+        using K = std::decay_t<decltype(key(std::declval<const T &>()))>;
+        if constexpr (std::is_trivially_copyable<T>::value &&
+                      radix_sortable<K>::value) {
+            if ((ptrdiff_t)size >= radix_min_size) {
+                radix_sort(data, size, key, descending);
+                return;
+            }
+        }
+        if (descending)
+            std::stable_sort(data, data + size, [&](const T &a, const T &b) {
+                return key(b) < key(a);
+            });
+        else
+            std::stable_sort(data, data + size, [&](const T &a, const T &b) {
+                return key(a) < key(b);
+            });
+    }
+
+    // Sort with a custom "comes before" predicate, e.g. MDT by timestamp
+    template <typename Compare> void mysort_by(Compare comp) {
+        pdq_sort(data, data + size, comp);
+    }
+
+    // Split the work across threads (0 = one per core)
+    void mysort_parallel(bool descending = false, unsigned threads = 0) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (descending)
+            parallel_sort(data, data + size, std::greater<T>(), threads);
+        else
+            parallel_sort(data, data + size, std::less<T>(), threads);
+    }
+
+    // manual clearing
+    void clear() {
+        for (size_t i = 0; i < size; ++i)
+            destroy(data + i);
+        size = 0;
+    }
+
+    // begin(): returns iterator to first element
+    iterator begin() { return iterator(data); }
+
+    // end(): returns iterator to one-past-last element
+    iterator end() { return iterator(data + size); }
+
+    const_iterator begin() const { return const_iterator(data); }
+    const_iterator end() const { return const_iterator(data + size); }
+
+    // Destructor to release memory
+    ~myvector() {
+        for (size_t i = 0; i < size; ++i) {
+            destroy(data + i); // manually destroy each object
+        }
+        deallocate(data, capacity);
+    }
+};
+
+// myvector whose memory comes from a std::pmr::memory_resource, e.g. a
+// monotonic_buffer_resource per request that is dropped in one go
+template <typename T>
+using pmr_myvector = myvector<T, std::pmr::polymorphic_allocator<T>>;
@@ -0,0 +1,142 @@
+#include "market_data_tick.hpp"
+#include "myvector.hpp"
+#include "vm_allocator.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <random>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Tick history replay: grow a myvector<MDT> one tick at a time to n ticks
+// (default 8M = 512 MB, pass a bigger n for the multi-GB case), then read
+// it back in random order. Compares the default doubling + memcpy growth
+// with vm_allocator on 4 KiB pages, transparent huge pages and hugetlbfs
+// pages (if vm.nr_hugepages is set). Reports growth time, page faults
+// during growth, and dTLB read misses during the random pass (needs
+// perf_event_paranoid <= 2, otherwise shown as n/a).
+
+using namespace std;
+using namespace chrono;
+
+volatile uint64_t sink;
+
+// dTLB read-miss counter for this thread, -1 if perf isn't available
+struct dtlb_counter {
+    int fd;
+
+    dtlb_counter() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    void start() {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    long long stop() {
+        long long count = -1;
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof count) != sizeof count)
+                count = -1;
+        }
+        return count;
+    }
+
+    ~dtlb_counter() {
+        if (fd >= 0)
+            close(fd);
+    }
+};
+
+long page_faults() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+template <typename Vec>
+void run(const string &name, Vec &v, size_t n, const myvector<uint32_t> &order) {
+    long faults_before = page_faults();
+    auto start_time = steady_clock::now();
+    MDT tick{};
+    for (size_t i = 0; i < n; ++i) {
+        tick.timestamp_ns = i;
+        v.mypush(tick);
+    }
+    auto grow = duration_cast<microseconds>(steady_clock::now() - start_time);
+    long faults = page_faults() - faults_before;
+
+    dtlb_counter dtlb;
+    dtlb.start();
+    start_time = steady_clock::now();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < order.size; ++i)
+        sum += v[order[i]].timestamp_ns;
+    auto replay = duration_cast<microseconds>(steady_clock::now() - start_time);
+    long long misses = dtlb.stop();
+    sink = sum;
+
+    cout << name << string(14 - name.size(), ' ') << grow.count() / 1000.0
+         << "\t\t" << faults << "\t\t" << replay.count() / 1000.0 << "\t\t";
+    if (misses >= 0)
+        cout << misses << "\n";
+    else
+        cout << "n/a\n";
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? stoull(argv[1]) : (size_t(1) << 23);
+    size_t reads = size_t(1) << 22;
+
+    mt19937 rng(11);
+    myvector<uint32_t> order;
+    order.reserve(reads);
+    for (size_t i = 0; i < reads; ++i)
+        order.emplace_back((uint32_t)(rng() % n));
+
+    // Reserve address space for twice what we'll need, like a replay that
+    // doesn't know the exact tick count up front
+    size_t reserve = 2 * n * sizeof(MDT);
+
+    cout << "ticks = " << n << " (" << n * sizeof(MDT) / (1 << 20)
+         << " MB), random reads = " << reads << "\n\n";
+    cout << "mode          grow (ms)\tpage faults\treplay (ms)\tdTLB misses\n";
+    {
+        myvector<MDT> v;
+        run("doubling", v, n, order);
+    }
+    {
+        myvector<MDT, vm_allocator<MDT>> v(
+            vm_allocator<MDT>(reserve, page_mode::small));
+        run("vm 4K", v, n, order);
+    }
+    {
+        myvector<MDT, vm_allocator<MDT>> v(
+            vm_allocator<MDT>(reserve, page_mode::transparent));
+        run("vm THP", v, n, order);
+    }
+    {
+        myvector<MDT, vm_allocator<MDT>> v(
+            vm_allocator<MDT>(reserve, page_mode::explicit_huge));
+        run("vm hugetlb", v, n, order);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "market_data_tick.hpp"
+#include "myvector.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Push throughput for int (realloc growth), MDT (over-aligned, memcpy
+// growth) and std::string (element-wise move growth):
+// - myvector::mypush letting the vector double on its own
+// - myvector::reserve up front + emplace_back
+// - std::vector::push_back for reference
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+volatile size_t sink;
+
+template <typename F> double mpushes_per_sec(size_t n, size_t rounds, F fill) {
+    auto start_time = steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+        sink = fill(n);
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)n * rounds * 1e3 / dur.count();
+}
+
+template <typename T, typename Make>
+void run(const char *name, size_t n, size_t rounds, Make make) {
+    double grow = mpushes_per_sec(n, rounds, [&](size_t count) {
+        myvector<T> v;
+        for (size_t i = 0; i < count; ++i)
+            v.mypush(make(i));
+        return v.size;
+    });
+    double reserved = mpushes_per_sec(n, rounds, [&](size_t count) {
+        myvector<T> v;
+        v.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            v.emplace_back(make(i));
+        return v.size;
+    });
+    double stdvec = mpushes_per_sec(n, rounds, [&](size_t count) {
+        vector<T> v;
+        for (size_t i = 0; i < count; ++i)
+            v.push_back(make(i));
+        return v.size();
+    });
+    cout << name << "\t" << grow << "\t\t" << reserved << "\t\t\t" << stdvec
+         << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? stoull(argv[1]) : 1000000;
+    size_t rounds = (argc > 2) ? stoull(argv[2]) : 10;
+    cout << "elements = " << n << ", rounds = " << rounds << "\n\n";
+    cout << "type\tmypush (M/s)\treserve+emplace (M/s)\tstd::vector (M/s)\n";
+
+    run<int>("int", n, rounds, [](size_t i) { return (int)i; });
+    run<MDT>("MDT", n, rounds, [](size_t i) {
+        MDT tick{};
+        tick.timestamp_ns = i;
+        return tick;
+    });
+    // Longer than the SSO buffer so every string owns heap memory
+    run<string>("string", n, rounds,
+                [](size_t i) { return string(24, (char)('a' + i % 26)); });
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "myvector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+// pdq_sort, mysort_parallel and std::sort against the old Lomuto quicksort
+// that myvector used to have, on random, sorted, reversed and few-unique
+// ints from 1K up to max_n (default 10M, pass 100000000 for the full 100M
+// run). mysort itself now radix sorts ints (see radix_sort_bench.cpp), so
+// pdq_sort is called directly. The old quicksort is quadratic on
+// sorted/reversed input and recurses once per element there, so it's
+// skipped above 20K.
+
+using namespace std;
+using namespace chrono;
+
+// The previous myvector::quicksort, kept here as the baseline
+void lomuto_quicksort(int *data, size_t low, size_t high) {
+    if (low >= high)
+        return;
+    int &pivot = data[high];
+    size_t i = low;
+    for (size_t j = low; j < high; ++j)
+        if (data[j] < pivot)
+            swap(data[i++], data[j]);
+    swap(data[i], data[high]);
+    if (i > 0)
+        lomuto_quicksort(data, low, i - 1);
+    lomuto_quicksort(data, i + 1, high);
+}
+
+void fill(myvector<int> &v, size_t n, const string &pattern) {
+    mt19937 rng(42);
+    v.clear();
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (pattern == "random")
+            v.emplace_back((int)rng());
+        else if (pattern == "sorted")
+            v.emplace_back((int)i);
+        else if (pattern == "reversed")
+            v.emplace_back((int)(n - i));
+        else // few-unique
+            v.emplace_back((int)(rng() % 16));
+    }
+}
+
+template <typename F>
+double time_ms(myvector<int> &v, size_t n, const string &pattern, F sort) {
+    fill(v, n, pattern);
+    auto start_time = steady_clock::now();
+    sort(v);
+    auto dur = duration_cast<microseconds>(steady_clock::now() - start_time);
+    for (size_t i = 1; i < v.size; ++i)
+        if (v[i - 1] > v[i]) {
+            cout << "NOT SORTED ";
+            break;
+        }
+    return dur.count() / 1000.0;
+}
+
+int main(int argc, char **argv) {
+    size_t max_n = (argc > 1) ? stoull(argv[1]) : 10000000;
+    unsigned threads = thread::hardware_concurrency();
+    cout << "times in ms, parallel uses " << threads << " threads\n\n";
+    cout << "pattern     n\t\told qsort\tstd::sort\tpdq_sort\tparallel\n";
+
+    const string patterns[] = {"random", "sorted", "reversed", "few-unique"};
+    myvector<int> v;
+    for (const string &pattern : patterns) {
+        for (size_t n = 1000; n <= max_n; n *= 10) {
+            cout << pattern << string(12 - pattern.size(), ' ') << n << "\t";
+            if (n <= 20000 || pattern == "random")
+                cout << time_ms(v, n, pattern, [](myvector<int> &x) {
+                    if (x.size > 1)
+                        lomuto_quicksort(x.data, 0, x.size - 1);
+                });
+            else
+                cout << "-";
+            cout << "\t\t" << time_ms(v, n, pattern, [](myvector<int> &x) {
+                std::sort(x.data, x.data + x.size);
+            });
+            cout << "\t\t"
+                 << time_ms(v, n, pattern, [](myvector<int> &x) {
+                        pdq_sort(x.data, x.data + x.size, std::less<int>());
+                    });
+            cout << "\t\t" << time_ms(v, n, pattern, [](myvector<int> &x) {
+                x.mysort_parallel();
+            }) << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+#define NO_ALLOC_SCOPE_HOOK
+#include "no_alloc_scope.hpp"
+#include "market_data_tick.hpp"
+#include "myvector.hpp"
+#include <csignal>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// What a strategy does per tick: reuses its buffers, unless it has to grow
+struct strategy {
+    myvector<MDT, std::allocator<MDT>> window;
+    std::vector<double> mids;
+
+    strategy() {
+        window.reserve(64);
+        mids.reserve(64);
+    }
+
+    void process_tick(const MDT &tick) {
+        if (window.size == 64) {
+            window.clear();
+            mids.clear();
+        }
+        window.mypush(tick);
+        mids.push_back((tick.bid_price + tick.ask_price) / 2);
+    }
+};
+
+int main() {
+    std::cout << "===== BEGIN TEST CASES =====\n\n";
+
+    // Test 1: Hook Is Installed
+    std::cout << "Test 1: Hook Is Installed\n";
+    std::cout << "Expected: hooked = 1\nGot:      hooked = "
+              << no_alloc_scope::hooked() << "\n\n";
+
+    strategy s;
+    MDT tick{};
+    tick.bid_price = 100.0;
+    tick.ask_price = 100.5;
+
+    // Test 2: Steady-State process_tick Allocates Nothing
+    std::cout << "Test 2: Steady-State process_tick Allocates Nothing\n";
+    size_t tick_allocs, tick_frees;
+    {
+        no_alloc_scope guard("process_tick");
+        for (int i = 0; i < 1000; ++i)
+            s.process_tick(tick);
+        tick_allocs = guard.allocations();
+        tick_frees = guard.deallocations();
+    }
+    std::cout << "Expected: allocations = 0, deallocations = 0\nGot:      "
+              << "allocations = " << tick_allocs
+              << ", deallocations = " << tick_frees << "\n\n";
+
+    // Test 3: Growth Inside A Scope Is Counted With Its Callsite
+    std::cout << "Test 3: Growth Inside A Scope Is Counted With Its Callsite\n";
+    size_t grow_allocs, grow_frees;
+    bool has_caller;
+    {
+        no_alloc_scope guard("growth");
+        std::vector<int> v;
+        for (int i = 0; i < 5; ++i)
+            v.push_back(i); // capacity 1, 2, 4, 8
+        grow_allocs = guard.allocations();
+        grow_frees = guard.deallocations();
+        has_caller = guard.first_caller() != nullptr;
+    }
+    std::cout << "Expected: allocations = 4, deallocations = 3, callsite = 1\n"
+              << "Got:      allocations = " << grow_allocs
+              << ", deallocations = " << grow_frees
+              << ", callsite = " << has_caller << "\n\n";
+
+    // Test 4: Nested Scopes And Other Threads
+    std::cout << "Test 4: Nested Scopes And Other Threads\n";
+    size_t outer_allocs, inner_allocs;
+    {
+        no_alloc_scope outer("outer");
+        std::string key(100, 'k');
+        {
+            no_alloc_scope inner("inner");
+            std::string copy = key;
+            std::thread other([] { std::vector<int> elsewhere(1000); });
+            other.join();
+            inner_allocs = inner.allocations();
+        }
+        outer_allocs = outer.allocations();
+    }
+    std::cout << "Expected: inner = 2, outer = 3\nGot:      inner = "
+              << inner_allocs << ", outer = " << outer_allocs << "\n\n";
+
+    // Test 5: on_alloc::abort Stops The Process
+    std::cout << "Test 5: on_alloc::abort Stops The Process\n";
+    std::cout.flush();
+    pid_t child = fork();
+    if (child == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDERR_FILENO);
+        no_alloc_scope guard("process_tick", on_alloc::abort);
+        s.process_tick(tick);
+        std::vector<int> oops(10);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    std::cout << "Expected: aborted = 1\nGot:      aborted = "
+              << (WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT) << "\n\n";
+
+    std::cout << "===== END TEST CASES =====\n";
+
+    return 0;
+}
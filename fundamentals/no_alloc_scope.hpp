@@ -0,0 +1,181 @@
+#pragma once
+#include <cstddef>   // for size_t
+#include <cstdio>    // for fprintf in the abort path
+#include <cstdlib>   // for malloc/free, abort
+
+/*
+    Proving a hot path allocation-free: TrackingAllocator's counting, but
+    for every operator new/delete of the thread, on a scope.
+
+    - no_alloc_scope is an RAII guard. While one is alive on a thread, every
+      operator new / delete made by that thread is counted, and the return
+      address of the first allocation is kept as a stack-less callsite id
+      (feed it to addr2line -e <binary>). Scopes nest; each sees what
+      happened since it opened
+    - on_alloc::abort turns the first allocation inside the scope into a
+      message on stderr and std::abort(), for tests and canaries. The
+      default on_alloc::record only counts, ask the guard before it closes
+    - the hook itself is opt-in: exactly one .cpp of the program defines
+      NO_ALLOC_SCOPE_HOOK before including this header, which replaces the
+      global operator new/delete (all forms) with malloc/free plus the
+      check. Without it the guards still compile and cost a few TLS writes,
+      but count nothing; no_alloc_scope::hooked() tells which
+    - with the hook in and no scope open, an allocation pays one
+      thread-local load and a predicted branch on top of malloc, so it can
+      stay in production builds
+    - only the current thread is watched; frees of memory another thread
+      allocated count as deallocations of the freeing thread
+    - only operator new/delete are seen: direct malloc/realloc (myvector's
+      realloc growth with std::allocator, C libraries) and mmap are not
+*/
+
+enum class on_alloc { record, abort };
+
+struct no_alloc_state {
+    unsigned depth = 0;       // open scopes on this thread
+    unsigned abort_depth = 0; // open scopes among them that abort
+    size_t allocations = 0;   // while depth > 0
+    size_t deallocations = 0;
+    const void *first_caller = nullptr; // since the innermost scope opened
+    const char *name = nullptr;         // innermost scope
+};
+
+// Trivial and constant-initialized, so the hook can use it before main
+// and from any thread without a TLS init guard
+inline thread_local no_alloc_state no_alloc_tls;
+inline bool no_alloc_hook_installed = false;
+
+// Slow path of the hook, only taken inside a scope
+__attribute__((noinline)) inline void no_alloc_violation(size_t bytes, const void *caller) {
+    no_alloc_state &s = no_alloc_tls;
+    ++s.allocations;
+    if (!s.first_caller)
+        s.first_caller = caller;
+    if (s.abort_depth) {
+        s.depth = s.abort_depth = 0; // fprintf may allocate
+        std::fprintf(stderr, "no_alloc_scope '%s': allocation of %zu bytes from %p\n",
+                     s.name, bytes, caller);
+        std::abort();
+    }
+}
+
+inline void no_alloc_note_allocation(size_t bytes, const void *caller) {
+    if (__builtin_expect(no_alloc_tls.depth != 0, 0))
+        no_alloc_violation(bytes, caller);
+}
+
+inline void no_alloc_note_deallocation(void *p) {
+    if (__builtin_expect(no_alloc_tls.depth != 0, 0) && p)
+        ++no_alloc_tls.deallocations;
+}
+
+class no_alloc_scope {
+    size_t allocations_at;
+    size_t deallocations_at;
+    const void *outer_first_caller;
+    const char *outer_name;
+    on_alloc mode;
+
+  public:
+    explicit no_alloc_scope(const char *name = "no_alloc_scope",
+                            on_alloc when = on_alloc::record)
+        : mode(when) {
+        no_alloc_state &s = no_alloc_tls;
+        allocations_at = s.allocations;
+        deallocations_at = s.deallocations;
+        outer_first_caller = s.first_caller;
+        outer_name = s.name;
+        s.first_caller = nullptr;
+        s.name = name;
+        s.abort_depth += mode == on_alloc::abort;
+        ++s.depth;
+    }
+
+    no_alloc_scope(const no_alloc_scope &) = delete;
+    no_alloc_scope &operator=(const no_alloc_scope &) = delete;
+
+    ~no_alloc_scope() {
+        no_alloc_state &s = no_alloc_tls;
+        --s.depth;
+        s.abort_depth -= mode == on_alloc::abort;
+        if (outer_first_caller || !s.first_caller)
+            s.first_caller = outer_first_caller;
+        s.name = outer_name;
+    }
+
+    // Made by this thread since the scope opened
+    size_t allocations() const { return no_alloc_tls.allocations - allocations_at; }
+    size_t deallocations() const { return no_alloc_tls.deallocations - deallocations_at; }
+
+    // Return address of the first allocation in the scope, nullptr if none
+    const void *first_caller() const { return no_alloc_tls.first_caller; }
+
+    static bool hooked() { return no_alloc_hook_installed; }
+};
+
+#ifdef NO_ALLOC_SCOPE_HOOK
+#include <new> // for bad_alloc, align_val_t, nothrow_t
+
+inline void *no_alloc_allocate(size_t bytes, const void *caller) {
+    no_alloc_note_allocation(bytes, caller);
+    if (void *p = std::malloc(bytes ? bytes : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+inline void *no_alloc_allocate_aligned(size_t bytes, std::align_val_t align, const void *caller) {
+    no_alloc_note_allocation(bytes, caller);
+    void *p = nullptr;
+    size_t a = static_cast<size_t>(align);
+    if (posix_memalign(&p, a < sizeof(void *) ? sizeof(void *) : a, bytes ? bytes : 1))
+        throw std::bad_alloc();
+    return p;
+}
+
+inline void no_alloc_deallocate(void *p) {
+    no_alloc_note_deallocation(p);
+    std::free(p);
+}
+
+static struct no_alloc_mark_installed {
+    no_alloc_mark_installed() { no_alloc_hook_installed = true; }
+} no_alloc_installed;
+
+#define NO_ALLOC_CALLER __builtin_return_address(0)
+
+void *operator new(size_t n) { return no_alloc_allocate(n, NO_ALLOC_CALLER); }
+void *operator new[](size_t n) { return no_alloc_allocate(n, NO_ALLOC_CALLER); }
+void *operator new(size_t n, const std::nothrow_t &) noexcept {
+    try {
+        return no_alloc_allocate(n, NO_ALLOC_CALLER);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void *operator new[](size_t n, const std::nothrow_t &) noexcept {
+    try {
+        return no_alloc_allocate(n, NO_ALLOC_CALLER);
+    } catch (...) {
+        return nullptr;
+    }
+}
+void *operator new(size_t n, std::align_val_t a) {
+    return no_alloc_allocate_aligned(n, a, NO_ALLOC_CALLER);
+}
+void *operator new[](size_t n, std::align_val_t a) {
+    return no_alloc_allocate_aligned(n, a, NO_ALLOC_CALLER);
+}
+
+void operator delete(void *p) noexcept { no_alloc_deallocate(p); }
+void operator delete[](void *p) noexcept { no_alloc_deallocate(p); }
+void operator delete(void *p, size_t) noexcept { no_alloc_deallocate(p); }
+void operator delete[](void *p, size_t) noexcept { no_alloc_deallocate(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { no_alloc_deallocate(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { no_alloc_deallocate(p); }
+void operator delete(void *p, std::align_val_t) noexcept { no_alloc_deallocate(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { no_alloc_deallocate(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { no_alloc_deallocate(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { no_alloc_deallocate(p); }
+
+#undef NO_ALLOC_CALLER
+#endif
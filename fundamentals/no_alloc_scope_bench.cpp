@@ -0,0 +1,62 @@
+#ifndef WITHOUT_HOOK
+#define NO_ALLOC_SCOPE_HOOK
+#endif
+#include "no_alloc_scope.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// What the hook costs a program that never opens a scope, and one that
+// does. Build twice and compare the "no scope" rows:
+//   g++ -std=c++17 -O2 no_alloc_scope_bench.cpp                 (hooked)
+//   g++ -std=c++17 -O2 -DWITHOUT_HOOK no_alloc_scope_bench.cpp  (libstdc++)
+// - new/delete: one 48-byte operator new + delete pair
+// - guard: opening and closing an empty no_alloc_scope
+
+using namespace std;
+using namespace chrono;
+
+struct order {
+    unsigned long long id, owner, ts;
+    double price;
+    unsigned qty, side;
+};
+
+volatile unsigned long long sink;
+
+double new_delete_ns(size_t n) {
+    auto start_time = steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        order *o = new order{i, 0, 0, 100.0, 1, 0};
+        asm volatile("" : : "r"(o) : "memory"); // keep the pair from being elided
+        sink = o->id;
+        delete o;
+    }
+    return (double)duration_cast<nanoseconds>(steady_clock::now() - start_time)
+               .count() / n;
+}
+
+double guard_ns(size_t n) {
+    auto start_time = steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        no_alloc_scope guard("tick");
+        sink = guard.allocations();
+    }
+    return (double)duration_cast<nanoseconds>(steady_clock::now() - start_time)
+               .count() / n;
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? stoull(argv[1]) : 20000000;
+    cout << "hook installed = " << no_alloc_scope::hooked() << ", ops = " << n
+         << "\n\n";
+    new_delete_ns(n / 10); // warm up malloc
+    cout << "new/delete, no scope\t" << new_delete_ns(n) << " ns\n";
+    {
+        no_alloc_scope guard("bench");
+        cout << "new/delete, in scope\t" << new_delete_ns(n) << " ns ("
+             << guard.allocations() << " counted)\n";
+    }
+    cout << "guard open/close\t" << guard_ns(n) << " ns\n";
+    return 0;
+}
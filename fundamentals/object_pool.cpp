@@ -0,0 +1,108 @@
+#include "caching_pool.hpp"
+#include "object_pool.hpp"
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// An order as the matching engine keeps it
+struct order {
+    uint64_t id;
+    double price;
+    uint32_t qty;
+    std::string owner;
+
+    order(uint64_t i, double p, uint32_t q, const std::string &o)
+        : id(i), price(p), qty(q), owner(o) {}
+};
+
+int main() {
+    std::cout << "===== BEGIN TEST CASES =====\n\n";
+
+    object_pool<order> orders(4);
+
+    // Test 1: construct/destroy Recycle Slots
+    std::cout << "Test 1: construct/destroy Recycle Slots\n";
+    order *a = orders.construct(1, 101.5, 10, "desk-a");
+    order *b = orders.construct(2, 101.75, 5, "desk-b");
+    orders.destroy(a);
+    order *c = orders.construct(3, 102.0, 1, "desk-c");
+    std::cout << "Expected: reused = 1, in use = 2, b = 2 desk-b\nGot:      "
+              << "reused = " << (c == a) << ", in use = " << orders.in_use()
+              << ", b = " << b->id << " " << b->owner << "\n\n";
+
+    // Test 2: Slabs Are Added In Batches
+    std::cout << "Test 2: Slabs Are Added In Batches\n";
+    order *more[6];
+    for (int i = 0; i < 6; ++i)
+        more[i] = orders.construct(10 + i, 100.0, 1, "bulk");
+    std::cout << "Expected: capacity = 8, in use = 8\nGot:      capacity = "
+              << orders.capacity() << ", in use = " << orders.in_use()
+              << "\n\n";
+    for (order *o : more)
+        orders.destroy(o);
+    orders.destroy(b);
+    orders.destroy(c);
+
+    // Test 3: Cache-Aligned Slots Get Their Own Line
+    std::cout << "Test 3: Cache-Aligned Slots Get Their Own Line\n";
+    object_pool<uint64_t, true> counters;
+    uint64_t *x = counters.construct(1);
+    uint64_t *y = counters.construct(2);
+    std::cout << "Expected: slot = 64, aligned = 1, distance = 64\nGot:      "
+              << "slot = " << object_pool<uint64_t, true>::slot_size()
+              << ", aligned = " << (reinterpret_cast<uintptr_t>(x) % 64 == 0)
+              << ", distance = "
+              << (reinterpret_cast<char *>(y) - reinterpret_cast<char *>(x))
+              << "\n\n";
+
+    // Test 4: caching_pool Returns Cross-Thread Frees In Batches
+    std::cout << "Test 4: caching_pool Returns Cross-Thread Frees In Batches\n";
+    caching_pool<order> shared_orders;
+    std::vector<order *> handoff;
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i)
+            handoff.push_back(shared_orders.construct(i, 100.0, 1, "feed"));
+    });
+    producer.join();
+    size_t from_slabs = shared_orders.slab_in_use();
+    std::thread consumer([&] {
+        for (order *o : handoff)
+            shared_orders.destroy(o);
+        shared_orders.flush_thread_cache();
+    });
+    consumer.join();
+    size_t in_depot = shared_orders.depot_size();
+    for (order *&o : handoff)
+        o = shared_orders.construct(0, 0.0, 0, "reused");
+    std::cout << "Expected: slab objects = 1024, depot = 1000, after reuse = "
+                 "1048\nGot:      slab objects = "
+              << from_slabs << ", depot = " << in_depot
+              << ", after reuse = " << shared_orders.slab_in_use() << "\n\n";
+    for (order *o : handoff)
+        shared_orders.destroy(o);
+
+    // Test 5: Evicting A Thread Cache Flushes It To Its Pool
+    std::cout << "Test 5: Evicting A Thread Cache Flushes It To Its Pool\n";
+    std::vector<std::unique_ptr<caching_pool<uint64_t>>> pools;
+    for (int i = 0; i < 9; ++i)
+        pools.emplace_back(new caching_pool<uint64_t>());
+    uint64_t *first[10];
+    for (uint64_t *&p : first)
+        p = pools[0]->construct(1);
+    for (uint64_t *p : first)
+        pools[0]->destroy(p); // 64 objects now in this thread's cache
+    for (int i = 1; i < 9; ++i) // 8 more pools push pools[0] out of the table
+        pools[i]->destroy(pools[i]->construct(2));
+    size_t flushed = pools[0]->depot_size();
+    pools[0]->destroy(pools[0]->construct(3));
+    std::cout << "Expected: depot = 64, slab objects = 64\nGot:      depot = "
+              << flushed << ", slab objects = " << pools[0]->slab_in_use()
+              << "\n\n";
+
+    std::cout << "===== END TEST CASES =====\n";
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>   // for size_t
+#include <new>       // for placement new, align_val_t
+#include <utility>   // for std::forward
+
+/*
+    Pool of fixed-size slots for one type, next to arena_allocator for
+    objects that come and go individually (orders, trie nodes, queue
+    nodes).
+
+    - slots come in slabs of slab_objects, allocated as one block when the
+      free list runs dry; slabs are only given back when the pool dies
+    - a free slot holds the free-list link in its own bytes (intrusive),
+      so allocate() and deallocate() are a pointer pop/push
+    - CacheAligned puts every object on its own 64-byte line(s), so two
+      objects touched by different threads never false-share
+    - allocate()/deallocate() hand out raw slots, construct()/destroy() also
+      run the constructor/destructor. Objects still live when the pool is
+      destroyed are not destructed
+    - not thread-safe
+*/
+template <typename T, bool CacheAligned = false> class object_pool {
+    static constexpr size_t slot_align =
+        CacheAligned ? (alignof(T) > 64 ? alignof(T) : 64)
+                     : (alignof(T) > alignof(void *) ? alignof(T)
+                                                     : alignof(void *));
+
+    union alignas(slot_align) slot {
+        slot *next; // while free
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Slabs are chained through their first slot so they can be freed
+    struct slab_header {
+        slab_header *next;
+    };
+
+    static constexpr size_t header_slots =
+        (sizeof(slab_header) + sizeof(slot) - 1) / sizeof(slot);
+
+    slot *free_list = nullptr;
+    slab_header *slabs = nullptr;
+    size_t slab_objects;
+    size_t slab_count = 0;
+    size_t live = 0;
+
+    // Allocate one slab and put its slots on the free list in address
+    // order, so a fresh pool hands out consecutive slots
+    void refill() {
+        slot *block = static_cast<slot *>(
+            ::operator new((header_slots + slab_objects) * sizeof(slot),
+                           std::align_val_t(slot_align)));
+        slab_header *header = reinterpret_cast<slab_header *>(block);
+        header->next = slabs;
+        slabs = header;
+        ++slab_count;
+
+        slot *first = block + header_slots;
+        for (size_t i = 0; i + 1 < slab_objects; ++i)
+            first[i].next = &first[i + 1];
+        first[slab_objects - 1].next = free_list;
+        free_list = first;
+    }
+
+  public:
+    explicit object_pool(size_t objects_per_slab = 256)
+        : slab_objects(objects_per_slab ? objects_per_slab : 1) {}
+
+    object_pool(const object_pool &) = delete;
+    object_pool &operator=(const object_pool &) = delete;
+
+    // Raw storage for one T
+    T *allocate() {
+        if (!free_list)
+            refill();
+        slot *s = free_list;
+        free_list = s->next;
+        ++live;
+        return reinterpret_cast<T *>(s->storage);
+    }
+
+    // Give a slot from allocate() back (no destructor runs)
+    void deallocate(T *p) {
+        slot *s = reinterpret_cast<slot *>(p);
+        s->next = free_list;
+        free_list = s;
+        --live;
+    }
+
+    template <typename... Args> T *construct(Args &&...args) {
+        T *p = allocate();
+        try {
+            return new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    void destroy(T *p) {
+        p->~T();
+        deallocate(p);
+    }
+
+    // Objects handed out and not yet given back
+    size_t in_use() const { return live; }
+
+    // Slots in all slabs
+    size_t capacity() const { return slab_count * slab_objects; }
+
+    static constexpr size_t slot_size() { return sizeof(slot); }
+
+    ~object_pool() {
+        while (slabs) {
+            slab_header *next = slabs->next;
+            ::operator delete(slabs, std::align_val_t(slot_align));
+            slabs = next;
+        }
+    }
+};
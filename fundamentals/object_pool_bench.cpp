@@ -0,0 +1,97 @@
+#include "object_pool.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Alloc/free pairs of 48-byte order objects, object_pool vs new/delete:
+// - steady churn: a working set of live orders, every step cancels a random
+//   one and books a new one in its place
+// - bursty churn: book a burst of orders, then cancel all of them in random
+//   order, repeat
+// Orders are trivially destructible here so the numbers are the allocator
+// alone.
+
+using namespace std;
+using namespace chrono;
+
+struct order {
+    uint64_t id;
+    double price;
+    uint32_t qty;
+    uint32_t side;
+    uint64_t owner;
+    uint64_t ts;
+};
+
+volatile uint64_t sink;
+
+template <typename New, typename Delete>
+double steady_ns(size_t live, size_t steps, New make, Delete drop) {
+    vector<order *> book(live);
+    for (size_t i = 0; i < live; ++i)
+        book[i] = make(i);
+    mt19937 rng(3);
+    auto start_time = steady_clock::now();
+    for (size_t s = 0; s < steps; ++s) {
+        size_t victim = rng() % live;
+        sink = book[victim]->id;
+        drop(book[victim]);
+        book[victim] = make(s);
+    }
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    for (order *o : book)
+        drop(o);
+    return (double)dur.count() / steps;
+}
+
+template <typename New, typename Delete>
+double bursty_ns(size_t burst, size_t rounds, New make, Delete drop) {
+    vector<order *> book(burst);
+    mt19937 rng(4);
+    auto start_time = steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < burst; ++i)
+            book[i] = make(i);
+        for (size_t i = burst - 1; i > 0; --i)
+            swap(book[i], book[rng() % (i + 1)]);
+        for (order *o : book) {
+            sink = o->id;
+            drop(o);
+        }
+    }
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)dur.count() / (burst * rounds);
+}
+
+int main(int argc, char **argv) {
+    size_t live = (argc > 1) ? stoull(argv[1]) : 100000;
+    size_t steps = (argc > 2) ? stoull(argv[2]) : 10000000;
+
+    auto heap_new = [](size_t i) { return new order{i, 100.0, 1, 0, 0, 0}; };
+    auto heap_delete = [](order *o) { delete o; };
+    object_pool<order> pool(1024);
+    auto pool_new = [&](size_t i) {
+        return pool.construct(order{i, 100.0, 1, 0, 0, 0});
+    };
+    auto pool_delete = [&](order *o) { pool.destroy(o); };
+    object_pool<order, true> aligned_pool(1024);
+    auto aligned_new = [&](size_t i) {
+        return aligned_pool.construct(order{i, 100.0, 1, 0, 0, 0});
+    };
+    auto aligned_delete = [&](order *o) { aligned_pool.destroy(o); };
+
+    cout << "live orders = " << live << ", steps = " << steps << "\n\n";
+    cout << "pattern\t\tnew/delete\tobject_pool\tcache-aligned pool  "
+            "(ns per alloc/free pair)\n";
+    cout << "steady\t\t" << steady_ns(live, steps, heap_new, heap_delete)
+         << "\t\t" << steady_ns(live, steps, pool_new, pool_delete) << "\t\t"
+         << steady_ns(live, steps, aligned_new, aligned_delete) << "\n";
+    size_t burst = 10000, rounds = steps / burst;
+    cout << "bursty\t\t" << bursty_ns(burst, rounds, heap_new, heap_delete)
+         << "\t\t" << bursty_ns(burst, rounds, pool_new, pool_delete) << "\t\t"
+         << bursty_ns(burst, rounds, aligned_new, aligned_delete) << "\n";
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "arena_allocator.hpp"
+#include "tracking_allocator.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A map/string-heavy request handler: each request builds an
+// unordered_map<string, vector<int>> of 64 fields (keys past the small
+// string buffer), does 256 lookups, erases and re-inserts half the fields,
+// then throws it all away. Run on:
+// - the default resource (new/delete)
+// - arena_resource, the arena is reset after every request
+// - unsynchronized_pool_resource over arena_resource, so erased nodes are
+//   recycled within the request; pool.release() + arena reset after it
+// TrackingResource under each one counts the upstream calls per request.
+
+using namespace std;
+using namespace chrono;
+
+using field_map = pmr::unordered_map<pmr::string, pmr::vector<int>>;
+
+volatile size_t sink;
+
+void handle_request(pmr::memory_resource *resource, const vector<string> &names,
+                    size_t request) {
+    field_map fields(resource);
+    for (size_t i = 0; i < names.size(); ++i)
+        fields[pmr::string(names[i], resource)].assign(8, (int)(i + request));
+    size_t hits = 0;
+    for (size_t i = 0; i < 256; ++i)
+        hits += fields.count(pmr::string(names[(i * 7) % names.size()], resource));
+    for (size_t i = 0; i < names.size(); i += 2)
+        fields.erase(pmr::string(names[i], resource));
+    for (size_t i = 0; i < names.size(); i += 2)
+        fields[pmr::string(names[i], resource)].assign(4, (int)i);
+    sink = hits + fields.size();
+}
+
+template <typename F> double us_per_request(size_t requests, F run) {
+    auto start_time = steady_clock::now();
+    for (size_t r = 0; r < requests; ++r)
+        run(r);
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return dur.count() / 1000.0 / requests;
+}
+
+void print(const char *name, double us, const TrackingResource &counted,
+           size_t requests) {
+    cout << name << us << "\t\t" << counted.get_allocations() / requests
+         << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t requests = (argc > 1) ? stoull(argv[1]) : 100000;
+    vector<string> names;
+    for (int i = 0; i < 64; ++i)
+        names.push_back("order.execution.report.field_" + to_string(i));
+
+    cout << "requests = " << requests << "\n\n";
+    cout << "resource\t\tus/request\tupstream allocs/request\n";
+
+    {
+        TrackingResource counted(pmr::new_delete_resource());
+        double us = us_per_request(requests, [&](size_t r) {
+            handle_request(&counted, names, r);
+        });
+        print("default\t\t\t", us, counted, requests);
+    }
+    {
+        arena_allocator arena;
+        arena_resource on_arena(arena);
+        TrackingResource counted(&on_arena);
+        double us = us_per_request(requests, [&](size_t r) {
+            handle_request(&counted, names, r);
+            arena.reset();
+        });
+        print("arena\t\t\t", us, counted, requests);
+    }
+    {
+        arena_allocator arena;
+        arena_resource on_arena(arena);
+        TrackingResource counted(&on_arena);
+        pmr::unsynchronized_pool_resource pool(&counted);
+        double us = us_per_request(requests, [&](size_t r) {
+            handle_request(&pool, names, r);
+            pool.release();
+            arena.reset();
+        });
+        print("pool over arena\t\t", us, counted, requests);
+    }
+    return 0;
+}
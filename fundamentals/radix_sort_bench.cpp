@@ -0,0 +1,89 @@
+#include "market_data_tick.hpp"
+#include "myvector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+// LSD radix sort (what mysort now does for numbers) against the comparison
+// sorts, for uint64_t timestamps, double prices and MDT records keyed by
+// timestamp_ns. Sizes go from 1M up to max_n by 10x (default 10M; pass
+// 500000000 for the big run, which needs ~8 GB for uint64_t plus scratch).
+
+using namespace std;
+using namespace chrono;
+
+template <typename T, typename Fill, typename Sort>
+double time_ms(myvector<T> &v, size_t n, Fill fill, Sort sort) {
+    mt19937_64 rng(7);
+    v.clear();
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        v.emplace_back(fill(rng, i));
+    auto start_time = steady_clock::now();
+    sort(v);
+    auto dur = duration_cast<microseconds>(steady_clock::now() - start_time);
+    return dur.count() / 1000.0;
+}
+
+int main(int argc, char **argv) {
+    size_t max_n = (argc > 1) ? stoull(argv[1]) : 10000000;
+    cout << "times in ms\n\n";
+    cout << "type      n\t\tradix\t\tpdq_sort\tstd::sort\n";
+
+    for (size_t n = 1000000; n <= max_n; n *= 10) {
+        // Timestamps within one trading day: the top bytes never change, so
+        // radix skips those passes
+        auto ts = [](mt19937_64 &rng, size_t) {
+            return (uint64_t)1700000000000000000ULL +
+                   rng() % 86400000000000ULL;
+        };
+        myvector<uint64_t> u;
+        cout << "uint64_t  " << n << "\t"
+             << time_ms(u, n, ts, [](myvector<uint64_t> &x) { x.mysort(); })
+             << "\t\t" << time_ms(u, n, ts, [](myvector<uint64_t> &x) {
+                    pdq_sort(x.data, x.data + x.size, less<uint64_t>());
+                })
+             << "\t\t" << time_ms(u, n, ts, [](myvector<uint64_t> &x) {
+                    std::sort(x.data, x.data + x.size);
+                })
+             << "\n";
+
+        auto px = [](mt19937_64 &rng, size_t) {
+            return 15000.0 + (double)(int64_t)(rng() % 200000 - 100000) / 8;
+        };
+        myvector<double> d;
+        cout << "double    " << n << "\t"
+             << time_ms(d, n, px, [](myvector<double> &x) { x.mysort(); })
+             << "\t\t" << time_ms(d, n, px, [](myvector<double> &x) {
+                    pdq_sort(x.data, x.data + x.size, less<double>());
+                })
+             << "\t\t" << time_ms(d, n, px, [](myvector<double> &x) {
+                    std::sort(x.data, x.data + x.size);
+                })
+             << "\n";
+
+        auto tick = [&](mt19937_64 &rng, size_t i) {
+            MDT t{};
+            t.timestamp_ns = ts(rng, i);
+            t.last_price = px(rng, i);
+            return t;
+        };
+        auto by_ts = [](const MDT &a, const MDT &b) {
+            return a.timestamp_ns < b.timestamp_ns;
+        };
+        myvector<MDT> m;
+        cout << "MDT       " << n << "\t"
+             << time_ms(m, n, tick, [](myvector<MDT> &x) {
+                    x.mysort_by_key([](const MDT &t) { return t.timestamp_ns; });
+                })
+             << "\t\t" << time_ms(m, n, tick, [&](myvector<MDT> &x) {
+                    pdq_sort(x.data, x.data + x.size, by_ts);
+                })
+             << "\t\t" << time_ms(m, n, tick, [&](myvector<MDT> &x) {
+                    std::sort(x.data, x.data + x.size, by_ts);
+                })
+             << "\n";
+    }
+    return 0;
+}
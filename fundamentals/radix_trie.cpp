@@ -0,0 +1,84 @@
+#include "radix_trie.hpp"
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+int main() {
+    std::cout << "===== BEGIN TEST CASES =====\n\n";
+
+    // Test 1: Shared Prefixes Share One Edge
+    std::cout << "Test 1: Shared Prefixes Share One Edge\n";
+    radix_trie symbols;
+    symbols.insert("equityusnasdaqaapl");
+    symbols.insert("equityusnasdaqmsft");
+    symbols.insert("equityusnyseibm");
+    // root -> "equityusn" -> {"asdaq" -> {"aapl", "msft"}, "yseibm"}
+    std::cout << "Expected: nodes = 6, aapl = 1, nasdaq = 0, prefix nasdaq = 1\n"
+              << "Got:      nodes = " << symbols.node_count()
+              << ", aapl = " << symbols.search("equityusnasdaqaapl")
+              << ", nasdaq = " << symbols.search("equityusnasdaq")
+              << ", prefix nasdaq = " << symbols.starts_with("equityusnasdaq")
+              << "\n\n";
+
+    // Test 2: A Key Ending Inside A Label Splits It
+    std::cout << "Test 2: A Key Ending Inside A Label Splits It\n";
+    bool added = symbols.insert("equityus");
+    bool again = symbols.insert("equityus");
+    std::cout << "Expected: added = 1, again = 0, nodes = 7, size = 4, "
+                 "equityus = 1\nGot:      added = "
+              << added << ", again = " << again
+              << ", nodes = " << symbols.node_count()
+              << ", size = " << symbols.size()
+              << ", equityus = " << symbols.search("equityus") << "\n\n";
+
+    // Test 3: Erase Merges Edges Back
+    std::cout << "Test 3: Erase Merges Edges Back\n";
+    bool erased = symbols.erase("equityusnasdaqmsft");
+    bool missing = symbols.erase("equityusnasdaq");
+    size_t after_one = symbols.node_count(); // "asdaq" + "aapl" merged
+    symbols.erase("equityus");               // "equityus" + "n" merged
+    std::cout << "Expected: erased = 1, missing = 0, nodes = 5, then 4, "
+                 "aapl = 1, ibm = 1\nGot:      erased = "
+              << erased << ", missing = " << missing << ", nodes = "
+              << after_one << ", then " << symbols.node_count()
+              << ", aapl = " << symbols.search("equityusnasdaqaapl")
+              << ", ibm = " << symbols.search("equityusnyseibm") << "\n\n";
+
+    // Test 4: Agrees With std::set Under Random Inserts And Erases
+    std::cout << "Test 4: Agrees With std::set Under Random Inserts And Erases\n";
+    std::mt19937 rng(9);
+    radix_trie keys;
+    std::set<std::string> reference;
+    size_t mismatches = 0;
+    auto random_key = [&] {
+        std::string k(rng() % 12, 'a');
+        for (char &ch : k)
+            ch = 'a' + rng() % 3;
+        return k;
+    };
+    for (int step = 0; step < 200000; ++step) {
+        std::string k = random_key();
+        if (rng() % 3 == 0)
+            mismatches += keys.erase(k) != (reference.erase(k) == 1);
+        else
+            mismatches += keys.insert(k) != reference.insert(k).second;
+    }
+    for (int i = 0; i < 20000; ++i) {
+        std::string k = random_key();
+        mismatches += keys.search(k) != (reference.count(k) == 1);
+    }
+    size_t live = keys.node_count();
+    for (const std::string &k : reference)
+        mismatches += !keys.erase(k);
+    std::cout << "Expected: mismatches = 0, nodes <= 2 * keys = 1, empty "
+                 "nodes = 1\nGot:      mismatches = "
+              << mismatches << ", nodes <= 2 * keys = "
+              << (live <= 2 * reference.size() + 1)
+              << ", empty nodes = " << keys.node_count() << "\n\n";
+
+    std::cout << "===== END TEST CASES =====\n";
+
+    return 0;
+}
@@ -0,0 +1,359 @@
+#pragma once
+#include "myvector.hpp"
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint32_t, uint8_t
+#include <cstring>     // for memcmp, memchr, memcpy
+#include <stdexcept>   // for std::out_of_range
+#include <string_view>
+
+/*
+    Path-compressed (radix / Patricia) trie: compact_trie's pools and 32-bit
+    indices, but every edge carries a whole label instead of one letter, so
+    a chain of single-child nodes is one node and a long shared prefix is
+    one memcmp.
+
+    - nodes are 16 bytes in one myvector: label offset and length into a
+      shared text pool, the child edge record, the child count and a
+      terminal flag. Any bytes can be in a key, not only 'a'..'z'
+    - a node's children sit in an edge record: the first label byte of
+      each child (found with memchr) and, parallel to it, the child
+      indices. Records hold 1, 2, 4 ... 256 children and come from
+      per-size free lists in one uint32_t pool, like compact_trie's nodes
+    - insert walks down comparing whole labels; a key that leaves a label
+      half way splits it: a new node takes the common part (same text
+      offset, nothing copied) and the old node keeps the rest
+    - erase unmarks the key, drops a node left without children and key,
+      and merges a keyless node with its only child. After a split the
+      two labels are adjacent in the text pool, so the merge just extends
+      the length; otherwise the joined label is appended to the text
+    - text left behind by merges is counted and the pool is repacked once
+      it is more than half dead. Node 0 is the root, with an empty label
+    - not thread-safe
+*/
+class radix_trie {
+    struct node {
+        uint32_t label;    // offset into text
+        uint32_t length;   // label bytes
+        uint32_t children; // edge record in edges, none if count == 0;
+                           // next free node while on the free list
+        uint16_t count;
+        uint8_t size_class; // record holds 1 << size_class children
+        bool terminal;
+    };
+    static_assert(sizeof(node) == 16, "node should be 16 bytes");
+
+    static constexpr uint32_t none = 0; // no record / no free node
+    static constexpr int size_classes = 9; // 1 .. 256 children
+
+    myvector<node> nodes;
+    myvector<char> text;
+    myvector<uint32_t> edges; // slot 0 unused so record 0 means none
+    uint32_t free_nodes = none;
+    uint32_t free_edges[size_classes] = {};
+    size_t keys = 0;
+    size_t dead_text = 0;
+    size_t live_nodes = 1;
+
+    // A record of 2^k children: first bytes, rounded up to whole slots,
+    // then the child indices
+    static size_t key_slots(int k) { return ((size_t(1) << k) + 3) / 4; }
+    static size_t record_slots(int k) { return key_slots(k) + (size_t(1) << k); }
+
+    uint8_t *first_bytes(const node &n) {
+        return reinterpret_cast<uint8_t *>(edges.data + n.children);
+    }
+    const uint8_t *first_bytes(const node &n) const {
+        return reinterpret_cast<const uint8_t *>(edges.data + n.children);
+    }
+    uint32_t *child_slots(const node &n) {
+        return edges.data + n.children + key_slots(n.size_class);
+    }
+    const uint32_t *child_slots(const node &n) const {
+        return edges.data + n.children + key_slots(n.size_class);
+    }
+
+    // Grow a pool by n elements, doubling its capacity when it is full
+    template <typename T> static size_t append(myvector<T> &pool, size_t n) {
+        size_t at = pool.size;
+        if (at + n > UINT32_MAX)
+            throw std::out_of_range("radix_trie: pool exceeds 32-bit indices");
+        if (at + n > pool.capacity)
+            pool.reserve(2 * pool.capacity > at + n ? 2 * pool.capacity : at + n);
+        pool.resize(at + n);
+        return at;
+    }
+
+    uint32_t allocate_record(int k) {
+        if (uint32_t at = free_edges[k]) {
+            free_edges[k] = edges.data[at];
+            return at;
+        }
+        return static_cast<uint32_t>(append(edges, record_slots(k)));
+    }
+
+    void free_record(uint32_t at, int k) {
+        edges.data[at] = free_edges[k];
+        free_edges[k] = at;
+    }
+
+    uint32_t new_node(uint32_t label, uint32_t length) {
+        uint32_t at = free_nodes;
+        if (at != none)
+            free_nodes = nodes.data[at].children;
+        else
+            at = static_cast<uint32_t>(append(nodes, 1));
+        nodes.data[at] = node{label, length, none, 0, 0, false};
+        ++live_nodes;
+        return at;
+    }
+
+    void free_node(uint32_t at) {
+        nodes.data[at].length = 0; // pack_text skips it
+        nodes.data[at].children = free_nodes;
+        free_nodes = at;
+        --live_nodes;
+    }
+
+    uint32_t add_text(const char *bytes, size_t n) {
+        size_t at = append(text, n);
+        std::memcpy(text.data + at, bytes, n);
+        return static_cast<uint32_t>(at);
+    }
+
+    // Position of the child starting with byte, or -1
+    int child_at(const node &n, uint8_t byte) const {
+        if (n.count == 0)
+            return -1;
+        const void *hit = std::memchr(first_bytes(n), byte, n.count);
+        return hit ? int(static_cast<const uint8_t *>(hit) - first_bytes(n)) : -1;
+    }
+
+    void add_child(uint32_t parent, uint32_t child) {
+        node &p = nodes.data[parent]; // only edges and text move below
+        if (p.count == 0 || p.count == (1u << p.size_class)) {
+            int k = p.count == 0 ? 0 : p.size_class + 1;
+            uint32_t record = allocate_record(k);
+            if (p.count) {
+                std::memcpy(edges.data + record, edges.data + p.children, p.count);
+                std::memcpy(edges.data + record + key_slots(k),
+                            edges.data + p.children + key_slots(p.size_class),
+                            p.count * sizeof(uint32_t));
+                free_record(p.children, p.size_class);
+            }
+            p.children = record;
+            p.size_class = static_cast<uint8_t>(k);
+        }
+        first_bytes(p)[p.count] = static_cast<uint8_t>(text.data[nodes.data[child].label]);
+        child_slots(p)[p.count] = child;
+        ++p.count;
+    }
+
+    // Drop child i (the last one takes its place), shrinking the record
+    // when it is down to a quarter
+    void remove_child(uint32_t parent, int i) {
+        node &p = nodes.data[parent];
+        --p.count;
+        first_bytes(p)[i] = first_bytes(p)[p.count];
+        child_slots(p)[i] = child_slots(p)[p.count];
+        if (p.count == 0) {
+            free_record(p.children, p.size_class);
+            p.children = none;
+            p.size_class = 0;
+        } else if (p.size_class >= 2 && p.count <= (1u << (p.size_class - 2))) {
+            int k = p.size_class - 1;
+            uint32_t record = allocate_record(k);
+            std::memcpy(edges.data + record, edges.data + p.children, p.count);
+            std::memcpy(edges.data + record + key_slots(k),
+                        edges.data + p.children + key_slots(p.size_class),
+                        p.count * sizeof(uint32_t));
+            free_record(p.children, p.size_class);
+            p.children = record;
+            p.size_class = static_cast<uint8_t>(k);
+        }
+    }
+
+    // Fold the only child of n into n, so n keeps its index and its edge
+    void merge_with_child(uint32_t n) {
+        node &p = nodes.data[n];
+        uint32_t c = child_slots(p)[0];
+        free_record(p.children, p.size_class);
+        node child = nodes.data[c];
+        if (child.label != p.label + p.length) { // else just extend p
+            uint32_t joined = static_cast<uint32_t>(append(text, p.length + child.length));
+            std::memcpy(text.data + joined, text.data + p.label, p.length);
+            std::memcpy(text.data + joined + p.length, text.data + child.label, child.length);
+            dead_text += p.length + child.length;
+            p.label = joined;
+        }
+        p.length += child.length;
+        p.children = child.children;
+        p.count = child.count;
+        p.size_class = child.size_class;
+        p.terminal = child.terminal;
+        free_node(c);
+        if (dead_text > text.size / 2)
+            pack_text();
+    }
+
+    // Rewrite text with only the labels in use
+    void pack_text() {
+        myvector<char> packed;
+        packed.reserve(text.size - dead_text);
+        for (size_t i = 1; i < nodes.size; ++i) {
+            node &n = nodes.data[i];
+            if (n.length == 0)
+                continue; // on the free list
+            size_t at = packed.size;
+            packed.resize(at + n.length);
+            std::memcpy(packed.data + at, text.data + n.label, n.length);
+            n.label = static_cast<uint32_t>(at);
+        }
+        text = std::move(packed);
+        dead_text = 0;
+    }
+
+  public:
+    radix_trie() {
+        nodes.reserve(1024);
+        nodes.resize(1);
+        nodes.data[0] = node{0, 0, none, 0, 0, false};
+        text.reserve(4096);
+        edges.reserve(4096);
+        edges.resize(1);
+    }
+
+    // Add key; false if it was already there
+    bool insert(std::string_view key) {
+        uint32_t n = 0;
+        size_t pos = 0;
+        while (pos < key.size()) {
+            int i = child_at(nodes.data[n], static_cast<uint8_t>(key[pos]));
+            if (i < 0) {
+                uint32_t leaf = new_node(add_text(key.data() + pos, key.size() - pos),
+                                         static_cast<uint32_t>(key.size() - pos));
+                nodes.data[leaf].terminal = true;
+                add_child(n, leaf);
+                ++keys;
+                return true;
+            }
+            uint32_t c = child_slots(nodes.data[n])[i];
+            const node &cn = nodes.data[c];
+            const char *label = text.data + cn.label;
+            size_t rest = key.size() - pos;
+            if (rest >= cn.length && std::memcmp(label, key.data() + pos, cn.length) == 0) {
+                pos += cn.length;
+                n = c;
+                continue;
+            }
+            // key leaves the label at m (m >= 1, the first bytes match)
+            size_t m = 1;
+            while (m < cn.length && m < rest && label[m] == key[pos + m])
+                ++m;
+            uint32_t mid = new_node(nodes.data[c].label, static_cast<uint32_t>(m));
+            nodes.data[c].label += static_cast<uint32_t>(m);
+            nodes.data[c].length -= static_cast<uint32_t>(m);
+            child_slots(nodes.data[n])[i] = mid; // same first byte
+            add_child(mid, c);
+            if (pos + m == key.size()) {
+                nodes.data[mid].terminal = true;
+            } else {
+                uint32_t leaf = new_node(add_text(key.data() + pos + m, rest - m),
+                                         static_cast<uint32_t>(rest - m));
+                nodes.data[leaf].terminal = true;
+                add_child(mid, leaf);
+            }
+            ++keys;
+            return true;
+        }
+        if (nodes.data[n].terminal)
+            return false;
+        nodes.data[n].terminal = true;
+        ++keys;
+        return true;
+    }
+
+    bool search(std::string_view key) const {
+        uint32_t n = 0;
+        size_t pos = 0;
+        while (pos < key.size()) {
+            const node &p = nodes.data[n];
+            int i = child_at(p, static_cast<uint8_t>(key[pos]));
+            if (i < 0)
+                return false;
+            n = child_slots(p)[i];
+            const node &c = nodes.data[n];
+            if (key.size() - pos < c.length ||
+                std::memcmp(text.data + c.label, key.data() + pos, c.length) != 0)
+                return false;
+            pos += c.length;
+        }
+        return nodes.data[n].terminal;
+    }
+
+    // Some key starts with prefix
+    bool starts_with(std::string_view prefix) const {
+        uint32_t n = 0;
+        size_t pos = 0;
+        while (pos < prefix.size()) {
+            const node &p = nodes.data[n];
+            int i = child_at(p, static_cast<uint8_t>(prefix[pos]));
+            if (i < 0)
+                return false;
+            n = child_slots(p)[i];
+            const node &c = nodes.data[n];
+            size_t cmp = prefix.size() - pos < c.length ? prefix.size() - pos : c.length;
+            if (std::memcmp(text.data + c.label, prefix.data() + pos, cmp) != 0)
+                return false;
+            pos += cmp;
+        }
+        return n != 0 || keys != 0;
+    }
+
+    // Remove key; false if it was not there
+    bool erase(std::string_view key) {
+        uint32_t parent = 0, n = 0;
+        int at = -1; // n's position among parent's children
+        size_t pos = 0;
+        while (pos < key.size()) {
+            const node &p = nodes.data[n];
+            int i = child_at(p, static_cast<uint8_t>(key[pos]));
+            if (i < 0)
+                return false;
+            uint32_t c = child_slots(p)[i];
+            const node &cn = nodes.data[c];
+            if (key.size() - pos < cn.length ||
+                std::memcmp(text.data + cn.label, key.data() + pos, cn.length) != 0)
+                return false;
+            pos += cn.length;
+            parent = n;
+            n = c;
+            at = i;
+        }
+        if (!nodes.data[n].terminal)
+            return false;
+        nodes.data[n].terminal = false;
+        --keys;
+        if (n == 0)
+            return true; // the root is never removed or merged
+        if (nodes.data[n].count == 0) {
+            dead_text += nodes.data[n].length;
+            remove_child(parent, at);
+            free_node(n);
+            if (parent != 0 && !nodes.data[parent].terminal && nodes.data[parent].count == 1)
+                merge_with_child(parent);
+            else if (dead_text > text.size / 2)
+                pack_text();
+        } else if (nodes.data[n].count == 1) {
+            merge_with_child(n);
+        }
+        return true;
+    }
+
+    size_t size() const { return keys; }
+    size_t node_count() const { return live_nodes; }
+
+    // Bytes reserved by the three pools
+    size_t memory_bytes() const {
+        return nodes.capacity * sizeof(node) + text.capacity + edges.capacity * sizeof(uint32_t);
+    }
+};
@@ -0,0 +1,143 @@
+#include "compact_trie.hpp"
+#include "radix_trie.hpp"
+#include "trie.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// Instrument keys with long shared prefixes (default 1M): venue + asset
+// class + underlying + expiry + strike, each segment 4-12 letters, about
+// 40 letters per key of which most is shared with the neighbours. Per
+// trie:
+// - bytes/key: heap growth while inserting, from mallinfo2
+// - insert / hit / miss ns: in key order, then shuffled, then with the
+//   last letter changed
+// - erase ns: erase every other key (radix_trie only, the others can't),
+//   then hits are looked up again
+// The pointer trie (trie.hpp) is skipped above max_pointer_keys (default
+// 300k, second argument) to fit in memory.
+
+using namespace std;
+using namespace chrono;
+
+vector<string> segment(mt19937_64 &rng, size_t count, size_t min_len,
+                       size_t max_len) {
+    vector<string> out(count);
+    for (string &s : out) {
+        s.resize(min_len + rng() % (max_len - min_len + 1));
+        for (char &ch : s)
+            ch = 'a' + rng() % 26;
+    }
+    return out;
+}
+
+vector<string> make_instruments(size_t n) {
+    mt19937_64 rng(13);
+    vector<string> venues = segment(rng, 8, 8, 12);
+    vector<string> classes = segment(rng, 6, 6, 10);
+    vector<string> expiries = segment(rng, 24, 8, 8);
+    vector<string> strikes = segment(rng, 40, 4, 6);
+    size_t per_underlying = venues.size() * classes.size() * expiries.size() * strikes.size();
+    vector<string> underlyings = segment(rng, n / per_underlying + 2, 4, 8);
+    size_t total = per_underlying * underlyings.size(), step = 1000003;
+    while (total % step == 0)
+        step += 2;
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; keys.size() < n && i < total; ++i) {
+        size_t k = (i * step) % total;
+        keys.push_back(venues[k % venues.size()] +
+                       classes[k / 8 % classes.size()] +
+                       underlyings[k / 48 % underlyings.size()] +
+                       expiries[k / 48 / underlyings.size() % expiries.size()] +
+                       strikes[k / 48 / underlyings.size() / 24]);
+    }
+    return keys;
+}
+
+size_t heap_bytes() {
+    struct mallinfo2 m = mallinfo2();
+    return m.uordblks + m.hblkhd;
+}
+
+template <typename F> double ns_per(const vector<string> &keys, F f) {
+    auto start_time = steady_clock::now();
+    for (const string &k : keys)
+        f(k);
+    return (double)duration_cast<nanoseconds>(steady_clock::now() - start_time)
+               .count() / keys.size();
+}
+
+size_t found;
+
+template <typename Insert, typename Search>
+void run(const string &name, const vector<string> &keys,
+         const vector<string> &hits, const vector<string> &misses,
+         Insert insert_key, Search search_key) {
+    size_t before = heap_bytes();
+    double insert_ns = ns_per(keys, insert_key);
+    double bytes = (double)(heap_bytes() - before) / keys.size();
+    auto search = [&](const string &k) { found += search_key(k); };
+    double hit_ns = ns_per(hits, search);
+    double miss_ns = ns_per(misses, search);
+    cout << name << "\t" << bytes << "\t\t" << insert_ns << "\t\t" << hit_ns
+         << "\t" << miss_ns;
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? stoull(argv[1]) : 1000000;
+    size_t max_pointer_keys = (argc > 2) ? stoull(argv[2]) : 300000;
+
+    vector<string> keys = make_instruments(n);
+    vector<string> hits = keys;
+    shuffle(hits.begin(), hits.end(), mt19937(5));
+    vector<string> misses = hits;
+    for (string &k : misses)
+        k.back() = k.back() == 'q' ? 'j' : 'q';
+    vector<string> evens;
+    for (size_t i = 0; i < hits.size(); i += 2)
+        evens.push_back(hits[i]);
+    size_t chars = 0;
+    for (const string &k : keys)
+        chars += k.size();
+    cout << "keys = " << keys.size() << ", avg length = "
+         << (double)chars / keys.size() << "\n\n";
+    cout << "trie\t\tbytes/key\tinsert ns\thit ns\tmiss ns\terase ns\thit "
+            "ns after\n";
+
+    if (n <= max_pointer_keys) {
+        trie *root = new trie();
+        run("pointer trie", keys, hits, misses,
+            [&](const string &k) { insert(root, k); },
+            [&](const string &k) { return search(root, k); });
+        cout << "\t-\n";
+        free_trie(root);
+    } else {
+        cout << "pointer trie\tskipped (> " << max_pointer_keys << " keys)\n";
+    }
+    {
+        compact_trie compact;
+        run("compact_trie", keys, hits, misses,
+            [&](const string &k) { compact.insert(k); },
+            [&](const string &k) { return compact.search(k); });
+        cout << "\t-\n";
+    }
+    {
+        radix_trie radix;
+        run("radix_trie", keys, hits, misses,
+            [&](const string &k) { radix.insert(k); },
+            [&](const string &k) { return radix.search(k); });
+        size_t nodes = radix.node_count();
+        double erase_ns = ns_per(evens, [&](const string &k) { radix.erase(k); });
+        double after_ns = ns_per(hits, [&](const string &k) { found += radix.search(k); });
+        cout << "\t" << erase_ns << "\t\t" << after_ns << "\n\t\t(" << nodes
+             << " nodes for " << keys.size() << " keys, "
+             << radix.node_count() << " after erasing half)\n";
+    }
+    cout << "(" << found << " found)\n";
+    return 0;
+}
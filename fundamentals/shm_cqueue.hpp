@@ -0,0 +1,212 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>   // for memcpy
+#include <fcntl.h>   // for O_* flags
+#include <stdexcept> // for std::runtime_error
+#include <string>
+#include <sys/mman.h> // for shm_open, mmap
+#include <sys/stat.h> // for fstat
+#include <type_traits>
+#include <unistd.h> // for ftruncate, close
+
+/*
+    Inter-process broadcast ring, the shared-memory cousin of spsc_cqueue.
+
+    The header and the slots live in one shm_open mapping, so one process
+    publishes and any number of other processes attach and read. Nothing in
+    the mapping is a pointer: slots are found by pos & mask from the start of
+    the mapping, so every process can map it at a different address.
+
+    - one writer, never blocks: like overwrite_cqueue a slow reader loses the
+      oldest entries instead of stalling the feed
+    - every reader keeps its own cursor (a reader object in its own process),
+      so readers don't write to shared memory at all
+    - each slot carries a sequence number, 2 * pos + 1 while the writer is
+      copying item pos in and 2 * pos + 2 once it is complete; a reader
+      checks it before and after copying out to detect being lapped
+    - the fast path is plain loads/stores on the mapping, no syscalls
+
+    T must be trivially copyable since it is copied as raw bytes between
+    processes.
+*/
+template <typename T> struct shm_cqueue {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "shm_cqueue copies T as raw bytes between processes");
+
+    static constexpr size_t cache_line = 64;
+    static constexpr uint64_t magic_value = 0x7368635f71756575; // "shc_queu"
+
+    struct header {
+        uint64_t magic;
+        uint64_t capacity;
+        uint64_t mask;
+        uint64_t slot_size; // sizeof(cell) of the creator, checked on attach
+        alignas(cache_line) std::atomic<uint64_t> tail; // next pos to write
+        alignas(cache_line) std::atomic<uint32_t> readers;
+    };
+
+    struct alignas(cache_line) cell {
+        std::atomic<uint64_t> seq;
+        T value;
+    };
+
+    // Reader-private cursor, lives in the reading process
+    struct reader {
+        uint64_t pos;
+        uint64_t dropped; // items overwritten before this reader got to them
+    };
+
+    header *hdr;
+    cell *cells;
+    size_t mapped_bytes;
+    int fd;
+    bool counted_reader;
+
+    shm_cqueue() : hdr(nullptr), cells(nullptr), mapped_bytes(0), fd(-1),
+                   counted_reader(false) {}
+
+    shm_cqueue(const shm_cqueue &) = delete;
+    shm_cqueue &operator=(const shm_cqueue &) = delete;
+
+    shm_cqueue(shm_cqueue &&other) noexcept
+        : hdr(other.hdr), cells(other.cells), mapped_bytes(other.mapped_bytes),
+          fd(other.fd), counted_reader(other.counted_reader) {
+        other.hdr = nullptr;
+        other.cells = nullptr;
+        other.fd = -1;
+        other.counted_reader = false;
+    }
+
+    static size_t bytes_for(size_t capacity) {
+        return sizeof(header) + capacity * sizeof(cell);
+    }
+
+    // Create (or truncate) the named segment and initialize it as the writer
+    static shm_cqueue create(const std::string &name, size_t requested) {
+        size_t capacity = 1;
+        while (capacity < requested)
+            capacity <<= 1;
+
+        shm_cqueue q;
+        q.fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+        if (q.fd < 0)
+            throw std::runtime_error("shm_open failed for " + name);
+        if (ftruncate(q.fd, bytes_for(capacity)) != 0)
+            throw std::runtime_error("ftruncate failed for " + name);
+        q.map(bytes_for(capacity));
+
+        // Fresh pages from ftruncate are zero, so every seq starts at 0
+        // ("never written"); the header is written last
+        q.hdr->capacity = capacity;
+        q.hdr->mask = capacity - 1;
+        q.hdr->slot_size = sizeof(cell);
+        q.hdr->tail.store(0, std::memory_order_relaxed);
+        q.hdr->readers.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        q.hdr->magic = magic_value;
+        return q;
+    }
+
+    // Map an existing segment created by another process and register as
+    // one of its readers
+    static shm_cqueue attach(const std::string &name) {
+        shm_cqueue q;
+        q.fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (q.fd < 0)
+            throw std::runtime_error("shm_open failed for " + name);
+        struct stat st;
+        if (fstat(q.fd, &st) != 0 || (size_t)st.st_size < sizeof(header))
+            throw std::runtime_error("segment too small: " + name);
+        q.map(st.st_size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (q.hdr->magic != magic_value || q.hdr->slot_size != sizeof(cell) ||
+            bytes_for(q.hdr->capacity) > q.mapped_bytes)
+            throw std::runtime_error("not a shm_cqueue of this type: " + name);
+        q.hdr->readers.fetch_add(1, std::memory_order_acq_rel);
+        q.counted_reader = true;
+        return q;
+    }
+
+    static void unlink(const std::string &name) { shm_unlink(name.c_str()); }
+
+    void map(size_t bytes) {
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                       0);
+        if (p == MAP_FAILED)
+            throw std::runtime_error("mmap failed");
+        hdr = static_cast<header *>(p);
+        cells = reinterpret_cast<cell *>(static_cast<char *>(p) +
+                                         sizeof(header));
+        mapped_bytes = bytes;
+    }
+
+    // Unmap; the segment itself stays until unlink() and the last detach
+    void detach() {
+        if (hdr) {
+            if (counted_reader)
+                hdr->readers.fetch_sub(1, std::memory_order_acq_rel);
+            munmap(hdr, mapped_bytes);
+        }
+        if (fd >= 0)
+            close(fd);
+        hdr = nullptr;
+        cells = nullptr;
+        fd = -1;
+        counted_reader = false;
+    }
+
+    size_t capacity() const { return hdr->capacity; }
+    uint32_t reader_count() const {
+        return hdr->readers.load(std::memory_order_acquire);
+    }
+
+    // Writer: publish one item, overwriting the oldest slot when full
+    void publish(const T &value) {
+        uint64_t pos = hdr->tail.load(std::memory_order_relaxed);
+        cell &c = cells[pos & hdr->mask];
+        c.seq.store(2 * pos + 1, std::memory_order_relaxed); // being written
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&c.value, &value, sizeof(T));
+        c.seq.store(2 * pos + 2, std::memory_order_release); // complete
+        hdr->tail.store(pos + 1, std::memory_order_release);
+    }
+
+    // Reader cursor starting at the next item to be published
+    reader make_reader() const {
+        return {hdr->tail.load(std::memory_order_acquire), 0};
+    }
+
+    // Reader: copy the next item into out, returns false if none is ready.
+    // If the writer lapped the reader it skips to the oldest item still
+    // held and adds what it missed to r.dropped.
+    bool try_read(reader &r, T &out) const {
+        for (;;) {
+            cell &c = cells[r.pos & hdr->mask];
+            uint64_t expected = 2 * r.pos + 2;
+            uint64_t before = c.seq.load(std::memory_order_acquire);
+            if (before < expected)
+                return false; // not published yet
+            if (before == expected) {
+                std::memcpy(&out, &c.value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (c.seq.load(std::memory_order_relaxed) == expected) {
+                    ++r.pos;
+                    return true;
+                }
+            }
+            // Slot was reused for a later lap, jump to the oldest live item
+            uint64_t tail = hdr->tail.load(std::memory_order_acquire);
+            uint64_t oldest = tail > hdr->capacity ? tail - hdr->capacity : 0;
+            // If that slot is being overwritten right now the next pass sees
+            // it as lapped again and moves on
+            if (oldest > r.pos) {
+                r.dropped += oldest - r.pos;
+                r.pos = oldest;
+            }
+        }
+    }
+
+    ~shm_cqueue() { detach(); }
+};
@@ -0,0 +1,549 @@
+#pragma once
+#include "myvector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h> // SSE2 / AVX2 / AVX-512 intrinsics
+#include <stdexcept>   // for std::out_of_range
+
+/*
+    Vectorized sum / min / max / find / count over double and int arrays
+    (myvector::data), with runtime CPU dispatch.
+
+    Every kernel exists for scalar, SSE2, AVX2 and AVX-512F. The wider ones
+    are compiled with function-level target attributes, so the program is
+    built for plain x86-64 and only calls AVX2/AVX-512 code after
+    __builtin_cpu_supports said the CPU has it. simd_use() pins an ISA
+    (e.g. for benchmarking), by default the widest available one is used.
+
+    Results:
+    - int sum is accumulated in 64 bits and is exact, so it is the same on
+      every ISA; min/max/find/count are exact for both types
+    - double sum has a fixed, documented order so that every ISA returns
+      the same bits: there are 16 partial sums, element i goes into
+      partial sum i % 16 (in increasing i), all starting at +0.0, and then
+      partial j += partial j + w for w = 8, 4, 2, 1; the result is partial
+      0. SSE2 keeps the 16 partials in 8 registers, AVX2 in 4, AVX-512 in
+      2, and the scalar loop in an array. Don't build with -ffast-math or
+      -ffp-contract=fast, either would let the compiler reorder the adds.
+    - double min/max assume no NaNs; with NaNs the result is unspecified
+*/
+
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+
+enum class simd_isa { scalar, sse2, avx2, avx512 };
+
+inline const char *simd_isa_name(simd_isa isa) {
+    switch (isa) {
+    case simd_isa::scalar:
+        return "scalar";
+    case simd_isa::sse2:
+        return "SSE2";
+    case simd_isa::avx2:
+        return "AVX2";
+    default:
+        return "AVX-512";
+    }
+}
+
+// Widest ISA this CPU supports
+inline simd_isa simd_detect() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return simd_isa::avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return simd_isa::avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return simd_isa::sse2;
+    return simd_isa::scalar;
+}
+
+inline simd_isa &simd_active() {
+    static simd_isa isa = simd_detect();
+    return isa;
+}
+
+// Use a specific ISA from now on; false if the CPU doesn't have it
+inline bool simd_use(simd_isa isa) {
+    if (isa > simd_detect())
+        return false;
+    simd_active() = isa;
+    return true;
+}
+
+constexpr size_t simd_sum_lanes = 16;
+
+// Fixed pairwise combination of the 16 partial sums (see above)
+inline double simd_reduce_lanes(double *lanes) {
+    for (size_t w = simd_sum_lanes / 2; w > 0; w >>= 1)
+        for (size_t j = 0; j < w; ++j)
+            lanes[j] += lanes[j + w];
+    return lanes[0];
+}
+
+// ------------------------------------- scalar -------------------------------------
+
+inline double simd_scalar_sum(const double *p, size_t n) {
+    double lanes[simd_sum_lanes] = {};
+    for (size_t i = 0; i < n; ++i)
+        lanes[i % simd_sum_lanes] += p[i];
+    return simd_reduce_lanes(lanes);
+}
+
+inline long long simd_scalar_sum(const int *p, size_t n) {
+    long long sum = 0;
+    for (size_t i = 0; i < n; ++i)
+        sum += p[i];
+    return sum;
+}
+
+template <bool Max, typename T> T simd_scalar_extreme(const T *p, size_t n) {
+    T best = p[0];
+    for (size_t i = 1; i < n; ++i)
+        if (Max ? p[i] > best : p[i] < best)
+            best = p[i];
+    return best;
+}
+
+// Count == false: index of the first match (n if none); true: match count
+template <bool Count, typename T>
+size_t simd_scalar_match(const T *p, size_t n, T key) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (p[i] == key) {
+            if (!Count)
+                return i;
+            ++count;
+        }
+    return Count ? count : n;
+}
+
+// ------------------------------------- SSE2 -------------------------------------
+
+// Baseline x86-64 has no popcnt instruction (__builtin_popcount becomes a
+// libgcc call), the SSE2 masks are at most 8 bits wide anyway
+inline unsigned simd_sse2_popcount(unsigned bits) {
+    bits = bits - ((bits >> 1) & 0x55);
+    bits = (bits & 0x33) + ((bits >> 2) & 0x33);
+    return (bits + (bits >> 4)) & 0x0f;
+}
+
+inline double simd_sse2_sum(const double *p, size_t n) {
+    __m128d acc[8];
+    for (int k = 0; k < 8; ++k)
+        acc[k] = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + simd_sum_lanes <= n; i += simd_sum_lanes)
+        for (int k = 0; k < 8; ++k)
+            acc[k] = _mm_add_pd(acc[k], _mm_loadu_pd(p + i + 2 * k));
+    double lanes[simd_sum_lanes];
+    for (int k = 0; k < 8; ++k)
+        _mm_storeu_pd(lanes + 2 * k, acc[k]);
+    for (size_t j = 0; i < n; ++i, ++j)
+        lanes[j] += p[i];
+    return simd_reduce_lanes(lanes);
+}
+
+inline long long simd_sse2_sum(const int *p, size_t n) {
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // SSE2 has no 32->64 sign extension, interleave with the sign bits
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(v, sign));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(v, sign));
+    }
+    long long parts[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(parts),
+                     _mm_add_epi64(acc0, acc1));
+    return parts[0] + parts[1] + simd_scalar_sum(p + i, n - i);
+}
+
+template <bool Max> double simd_sse2_extreme(const double *p, size_t n) {
+    __m128d acc0 = _mm_set1_pd(p[0]), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d a = _mm_loadu_pd(p + i), b = _mm_loadu_pd(p + i + 2);
+        acc0 = Max ? _mm_max_pd(acc0, a) : _mm_min_pd(acc0, a);
+        acc1 = Max ? _mm_max_pd(acc1, b) : _mm_min_pd(acc1, b);
+    }
+    double lanes[5];
+    _mm_storeu_pd(lanes, acc0);
+    _mm_storeu_pd(lanes + 2, acc1);
+    lanes[4] = i < n ? simd_scalar_extreme<Max>(p + i, n - i) : lanes[0];
+    return simd_scalar_extreme<Max>(lanes, 5);
+}
+
+template <bool Max> int simd_sse2_extreme(const int *p, size_t n) {
+    // SSE2 has no pminsd/pmaxsd, select with a compare mask instead
+    __m128i acc = _mm_set1_epi32(p[0]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        __m128i take = Max ? _mm_cmpgt_epi32(v, acc) : _mm_cmplt_epi32(v, acc);
+        acc = _mm_or_si128(_mm_and_si128(take, v), _mm_andnot_si128(take, acc));
+    }
+    int lanes[5];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+    lanes[4] = i < n ? simd_scalar_extreme<Max>(p + i, n - i) : lanes[0];
+    return simd_scalar_extreme<Max>(lanes, 5);
+}
+
+template <bool Count>
+size_t simd_sse2_match(const double *p, size_t n, double key) {
+    __m128d k = _mm_set1_pd(key);
+    size_t count = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        unsigned bits =
+            _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i), k)) |
+            _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p + i + 2), k)) << 2;
+        if (Count)
+            count += simd_sse2_popcount(bits);
+        else if (bits)
+            return i + __builtin_ctz(bits);
+    }
+    size_t rest = simd_scalar_match<Count>(p + i, n - i, key);
+    return Count ? count + rest : i + rest;
+}
+
+template <bool Count> size_t simd_sse2_match(const int *p, size_t n, int key) {
+    __m128i k = _mm_set1_epi32(key);
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 4));
+        unsigned bits =
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, k))) |
+            _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(b, k))) << 4;
+        if (Count)
+            count += simd_sse2_popcount(bits);
+        else if (bits)
+            return i + __builtin_ctz(bits);
+    }
+    size_t rest = simd_scalar_match<Count>(p + i, n - i, key);
+    return Count ? count + rest : i + rest;
+}
+
+// ------------------------------------- AVX2 -------------------------------------
+
+SIMD_TARGET_AVX2 inline double simd_avx2_sum(const double *p, size_t n) {
+    __m256d acc[4];
+    for (int k = 0; k < 4; ++k)
+        acc[k] = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + simd_sum_lanes <= n; i += simd_sum_lanes)
+        for (int k = 0; k < 4; ++k)
+            acc[k] = _mm256_add_pd(acc[k], _mm256_loadu_pd(p + i + 4 * k));
+    double lanes[simd_sum_lanes];
+    for (int k = 0; k < 4; ++k)
+        _mm256_storeu_pd(lanes + 4 * k, acc[k]);
+    for (size_t j = 0; i < n; ++i, ++j)
+        lanes[j] += p[i];
+    return simd_reduce_lanes(lanes);
+}
+
+SIMD_TARGET_AVX2 inline long long simd_avx2_sum(const int *p, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        __m128i b =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 4));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(a));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(b));
+    }
+    long long parts[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(parts),
+                        _mm256_add_epi64(acc0, acc1));
+    return parts[0] + parts[1] + parts[2] + parts[3] +
+           simd_scalar_sum(p + i, n - i);
+}
+
+template <bool Max>
+SIMD_TARGET_AVX2 double simd_avx2_extreme(const double *p, size_t n) {
+    __m256d acc0 = _mm256_set1_pd(p[0]), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_loadu_pd(p + i), b = _mm256_loadu_pd(p + i + 4);
+        acc0 = Max ? _mm256_max_pd(acc0, a) : _mm256_min_pd(acc0, a);
+        acc1 = Max ? _mm256_max_pd(acc1, b) : _mm256_min_pd(acc1, b);
+    }
+    double lanes[9];
+    _mm256_storeu_pd(lanes, acc0);
+    _mm256_storeu_pd(lanes + 4, acc1);
+    lanes[8] = i < n ? simd_scalar_extreme<Max>(p + i, n - i) : lanes[0];
+    return simd_scalar_extreme<Max>(lanes, 9);
+}
+
+template <bool Max>
+SIMD_TARGET_AVX2 int simd_avx2_extreme(const int *p, size_t n) {
+    __m256i acc0 = _mm256_set1_epi32(p[0]), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 8));
+        acc0 = Max ? _mm256_max_epi32(acc0, a) : _mm256_min_epi32(acc0, a);
+        acc1 = Max ? _mm256_max_epi32(acc1, b) : _mm256_min_epi32(acc1, b);
+    }
+    int lanes[17];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes + 8), acc1);
+    lanes[16] = i < n ? simd_scalar_extreme<Max>(p + i, n - i) : lanes[0];
+    return simd_scalar_extreme<Max>(lanes, 17);
+}
+
+template <bool Count>
+SIMD_TARGET_AVX2 size_t simd_avx2_match(const double *p, size_t n,
+                                        double key) {
+    __m256d k = _mm256_set1_pd(key);
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_cmp_pd(_mm256_loadu_pd(p + i), k, _CMP_EQ_OQ);
+        __m256d b = _mm256_cmp_pd(_mm256_loadu_pd(p + i + 4), k, _CMP_EQ_OQ);
+        unsigned bits = _mm256_movemask_pd(a) | _mm256_movemask_pd(b) << 4;
+        if (Count)
+            count += __builtin_popcount(bits);
+        else if (bits)
+            return i + __builtin_ctz(bits);
+    }
+    size_t rest = simd_scalar_match<Count>(p + i, n - i, key);
+    return Count ? count + rest : i + rest;
+}
+
+template <bool Count>
+SIMD_TARGET_AVX2 size_t simd_avx2_match(const int *p, size_t n, int key) {
+    __m256i k = _mm256_set1_epi32(key);
+    size_t count = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 8));
+        unsigned bits =
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, k))) |
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(b, k)))
+                << 8;
+        if (Count)
+            count += __builtin_popcount(bits);
+        else if (bits)
+            return i + __builtin_ctz(bits);
+    }
+    size_t rest = simd_scalar_match<Count>(p + i, n - i, key);
+    return Count ? count + rest : i + rest;
+}
+
+// ------------------------------------- AVX-512 -------------------------------------
+
+// GCC 12's avx512fintrin.h builds the widening and reduce intrinsics on
+// _mm512_undefined_*, which -Wall reports as uninitialized once inlined here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+SIMD_TARGET_AVX512 inline double simd_avx512_sum(const double *p, size_t n) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + simd_sum_lanes <= n; i += simd_sum_lanes) {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(p + i));
+        acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(p + i + 8));
+    }
+    double lanes[simd_sum_lanes];
+    _mm512_storeu_pd(lanes, acc0);
+    _mm512_storeu_pd(lanes + 8, acc1);
+    for (size_t j = 0; i < n; ++i, ++j)
+        lanes[j] += p[i];
+    return simd_reduce_lanes(lanes);
+}
+
+SIMD_TARGET_AVX512 inline long long simd_avx512_sum(const int *p, size_t n) {
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        __m256i b =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i + 8));
+        acc0 = _mm512_add_epi64(acc0, _mm512_cvtepi32_epi64(a));
+        acc1 = _mm512_add_epi64(acc1, _mm512_cvtepi32_epi64(b));
+    }
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1)) +
+           simd_scalar_sum(p + i, n - i);
+}
+
+template <bool Max>
+SIMD_TARGET_AVX512 double simd_avx512_extreme(const double *p, size_t n) {
+    __m512d acc0 = _mm512_set1_pd(p[0]), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512d a = _mm512_loadu_pd(p + i), b = _mm512_loadu_pd(p + i + 8);
+        acc0 = Max ? _mm512_max_pd(acc0, a) : _mm512_min_pd(acc0, a);
+        acc1 = Max ? _mm512_max_pd(acc1, b) : _mm512_min_pd(acc1, b);
+    }
+    double lanes[17];
+    _mm512_storeu_pd(lanes, acc0);
+    _mm512_storeu_pd(lanes + 8, acc1);
+    lanes[16] = i < n ? simd_scalar_extreme<Max>(p + i, n - i) : lanes[0];
+    return simd_scalar_extreme<Max>(lanes, 17);
+}
+
+template <bool Max>
+SIMD_TARGET_AVX512 int simd_avx512_extreme(const int *p, size_t n) {
+    __m512i acc0 = _mm512_set1_epi32(p[0]), acc1 = acc0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512i a = _mm512_loadu_si512(p + i), b = _mm512_loadu_si512(p + i + 16);
+        acc0 = Max ? _mm512_max_epi32(acc0, a) : _mm512_min_epi32(acc0, a);
+        acc1 = Max ? _mm512_max_epi32(acc1, b) : _mm512_min_epi32(acc1, b);
+    }
+    int best = Max ? _mm512_reduce_max_epi32(_mm512_max_epi32(acc0, acc1))
+                   : _mm512_reduce_min_epi32(_mm512_min_epi32(acc0, acc1));
+    if (i < n) {
+        int rest = simd_scalar_extreme<Max>(p + i, n - i);
+        best = (Max ? rest > best : rest < best) ? rest : best;
+    }
+    return best;
+}
+
+template <bool Count>
+SIMD_TARGET_AVX512 size_t simd_avx512_match(const double *p, size_t n,
+                                            double key) {
+    __m512d k = _mm512_set1_pd(key);
+    size_t count = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        unsigned bits =
+            _mm512_cmp_pd_mask(_mm512_loadu_pd(p + i), k, _CMP_EQ_OQ) |
+            _mm512_cmp_pd_mask(_mm512_loadu_pd(p + i + 8), k, _CMP_EQ_OQ)
+                << 8;
+        if (Count)
+            count += __builtin_popcount(bits);
+        else if (bits)
+            return i + __builtin_ctz(bits);
+    }
+    size_t rest = simd_scalar_match<Count>(p + i, n - i, key);
+    return Count ? count + rest : i + rest;
+}
+
+template <bool Count>
+SIMD_TARGET_AVX512 size_t simd_avx512_match(const int *p, size_t n, int key) {
+    __m512i k = _mm512_set1_epi32(key);
+    size_t count = 0, i = 0;
+    for (; i + 32 <= n; i += 32) {
+        uint32_t bits =
+            _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(p + i), k) |
+            (uint32_t)_mm512_cmpeq_epi32_mask(_mm512_loadu_si512(p + i + 16), k)
+                << 16;
+        if (Count)
+            count += __builtin_popcount(bits);
+        else if (bits)
+            return i + __builtin_ctz(bits);
+    }
+    size_t rest = simd_scalar_match<Count>(p + i, n - i, key);
+    return Count ? count + rest : i + rest;
+}
+
+#pragma GCC diagnostic pop
+
+// ------------------------------------- dispatch -------------------------------------
+
+inline double simd_sum(const double *p, size_t n) {
+    switch (simd_active()) {
+    case simd_isa::avx512:
+        return simd_avx512_sum(p, n);
+    case simd_isa::avx2:
+        return simd_avx2_sum(p, n);
+    case simd_isa::sse2:
+        return simd_sse2_sum(p, n);
+    default:
+        return simd_scalar_sum(p, n);
+    }
+}
+
+inline long long simd_sum(const int *p, size_t n) {
+    switch (simd_active()) {
+    case simd_isa::avx512:
+        return simd_avx512_sum(p, n);
+    case simd_isa::avx2:
+        return simd_avx2_sum(p, n);
+    case simd_isa::sse2:
+        return simd_sse2_sum(p, n);
+    default:
+        return simd_scalar_sum(p, n);
+    }
+}
+
+template <bool Max, typename T> T simd_extreme(const T *p, size_t n) {
+    if (n == 0)
+        throw std::out_of_range("min/max of an empty range");
+    switch (simd_active()) {
+    case simd_isa::avx512:
+        return simd_avx512_extreme<Max>(p, n);
+    case simd_isa::avx2:
+        return simd_avx2_extreme<Max>(p, n);
+    case simd_isa::sse2:
+        return simd_sse2_extreme<Max>(p, n);
+    default:
+        return simd_scalar_extreme<Max>(p, n);
+    }
+}
+
+template <bool Count, typename T>
+size_t simd_match(const T *p, size_t n, T key) {
+    switch (simd_active()) {
+    case simd_isa::avx512:
+        return simd_avx512_match<Count>(p, n, key);
+    case simd_isa::avx2:
+        return simd_avx2_match<Count>(p, n, key);
+    case simd_isa::sse2:
+        return simd_sse2_match<Count>(p, n, key);
+    default:
+        return simd_scalar_match<Count>(p, n, key);
+    }
+}
+
+inline double simd_min(const double *p, size_t n) {
+    return simd_extreme<false>(p, n);
+}
+inline int simd_min(const int *p, size_t n) { return simd_extreme<false>(p, n); }
+inline double simd_max(const double *p, size_t n) {
+    return simd_extreme<true>(p, n);
+}
+inline int simd_max(const int *p, size_t n) { return simd_extreme<true>(p, n); }
+
+// Index of the first element equal to key, n if there is none
+inline size_t simd_find(const double *p, size_t n, double key) {
+    return simd_match<false>(p, n, key);
+}
+inline size_t simd_find(const int *p, size_t n, int key) {
+    return simd_match<false>(p, n, key);
+}
+
+// Number of elements equal to key
+inline size_t simd_count(const double *p, size_t n, double key) {
+    return simd_match<true>(p, n, key);
+}
+inline size_t simd_count(const int *p, size_t n, int key) {
+    return simd_match<true>(p, n, key);
+}
+
+// Same kernels straight on a myvector's storage
+template <typename T, typename A> auto simd_sum(const myvector<T, A> &v) {
+    return simd_sum(v.data, v.size);
+}
+template <typename T, typename A> T simd_min(const myvector<T, A> &v) {
+    return simd_min(v.data, v.size);
+}
+template <typename T, typename A> T simd_max(const myvector<T, A> &v) {
+    return simd_max(v.data, v.size);
+}
+template <typename T, typename A>
+size_t simd_find(const myvector<T, A> &v, T key) {
+    return simd_find(v.data, v.size, key);
+}
+template <typename T, typename A>
+size_t simd_count(const myvector<T, A> &v, T key) {
+    return simd_count(v.data, v.size, key);
+}
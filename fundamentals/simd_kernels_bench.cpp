@@ -0,0 +1,58 @@
+#include "simd_kernels.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// GB/s of every simd_kernels.hpp kernel on every ISA this CPU has, for
+// double and int. The default 4096 elements stay in L1 so the kernels are
+// compute bound; pass e.g. 50000000 to see them all hit the memory
+// bandwidth wall instead. Find/count look for a key that isn't there, so
+// they scan the whole array like the others.
+
+using namespace std;
+using namespace chrono;
+
+volatile double sink;
+
+template <typename F> double gb_per_sec(size_t bytes, size_t rounds, F kernel) {
+    auto start_time = steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+        sink = (double)kernel();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)bytes * rounds / dur.count();
+}
+
+template <typename T> void run(const char *name, size_t n, size_t rounds) {
+    myvector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        v.emplace_back((T)(i % 1000));
+    size_t bytes = n * sizeof(T);
+
+    cout << name << "\n";
+    for (simd_isa isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2,
+                         simd_isa::avx512}) {
+        if (!simd_use(isa))
+            continue;
+        string isa_name = simd_isa_name(isa);
+        cout << "  " << isa_name << string(10 - isa_name.size(), ' ')
+             << gb_per_sec(bytes, rounds, [&] { return simd_sum(v); }) << "\t"
+             << gb_per_sec(bytes, rounds, [&] { return simd_min(v); }) << "\t"
+             << gb_per_sec(bytes, rounds, [&] { return simd_max(v); }) << "\t"
+             << gb_per_sec(bytes, rounds, [&] { return simd_find(v, (T)-1); })
+             << "\t"
+             << gb_per_sec(bytes, rounds, [&] { return simd_count(v, (T)-1); })
+             << "\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? stoull(argv[1]) : 4096;
+    size_t rounds = (argc > 2) ? stoull(argv[2]) : (1ULL << 28) / n + 1;
+    cout << "elements = " << n << ", rounds = " << rounds
+         << ", detected = " << simd_isa_name(simd_detect()) << "\n\n";
+    cout << "GB/s        sum\tmin\tmax\tfind\tcount\n";
+    run<double>("double", n, rounds);
+    run<int>("int", n, rounds);
+    return 0;
+}
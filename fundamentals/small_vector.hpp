@@ -0,0 +1,154 @@
+#pragma once
+#include "myiterator.hpp"
+#include <cstddef>  // for size_t
+#include <iostream> // for myprint
+#include <memory>   // for std::allocator, allocator_traits
+#include <new>      // for placement new
+#include <type_traits> // for std::is_nothrow_move_constructible
+#include <utility>  // for std::move
+
+/*
+    myvector with the first N elements stored inline.
+
+    myvector allocates on the first mypush and then doubles from 1, so a
+    short vector costs several allocations and moves. small_vector starts
+    with data pointing at its own inline buffer (capacity N) and only goes
+    to the heap once it grows past N, after which it behaves like myvector.
+
+    Because data may point into the object itself, copying has to rebuild
+    the elements instead of copying the pointer.
+
+    Alloc only provides the heap buffer after the spill, like myvector's
+    (so TrackingAllocator counts the spills); the inline buffer is never
+    allocated.
+*/
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+struct small_vector : private Alloc { // empty allocators take no space
+    static_assert(N > 0, "use myvector for N == 0");
+
+    T *data;         // inline_buf until we spill, then heap
+    size_t size;     // Number of elements currently used
+    size_t capacity; // N while inline
+    alignas(T) unsigned char inline_buf[N * sizeof(T)];
+
+    using iterator = myiterator<T>;
+    using const_iterator = myiterator<const T>;
+    using allocator_type = Alloc;
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    small_vector()
+        : data(reinterpret_cast<T *>(inline_buf)), size(0), capacity(N) {}
+
+    explicit small_vector(const Alloc &alloc)
+        : Alloc(alloc), data(reinterpret_cast<T *>(inline_buf)), size(0),
+          capacity(N) {}
+
+    small_vector(const small_vector &other)
+        : small_vector(alloc_traits::select_on_container_copy_construction(
+              other.get_allocator())) {
+        reserve(other.size);
+        for (size_t i = 0; i < other.size; ++i)
+            new (data + i) T(other.data[i]);
+        size = other.size;
+    }
+
+    // Steals a heap buffer (and the allocator that owns it); inline
+    // elements have to be moved one by one. other is left empty (and inline)
+    small_vector(small_vector &&other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+        : small_vector(Alloc(std::move(other.get_allocator()))) {
+        if (other.is_inline()) {
+            for (size_t i = 0; i < other.size; ++i)
+                new (data + i) T(std::move(other.data[i]));
+            size = other.size;
+            other.clear();
+        } else {
+            data = other.data;
+            size = other.size;
+            capacity = other.capacity;
+            other.data = reinterpret_cast<T *>(other.inline_buf);
+            other.size = 0;
+            other.capacity = N;
+        }
+    }
+
+    small_vector &operator=(const small_vector &) = delete;
+
+    Alloc &get_allocator() { return *this; }
+    const Alloc &get_allocator() const { return *this; }
+
+    bool is_inline() const {
+        return data == reinterpret_cast<const T *>(inline_buf);
+    }
+
+    // Allocate memory
+    T *allocate(size_t obj) {
+        return alloc_traits::allocate(get_allocator(), obj);
+    }
+
+    // Deallocate memory, obj is the capacity it was allocated with; the
+    // inline buffer is never freed
+    void deallocate(T *dataptr, size_t obj) {
+        if (dataptr != reinterpret_cast<T *>(inline_buf))
+            alloc_traits::deallocate(get_allocator(), dataptr, obj);
+    }
+
+    // Move to a heap buffer of at least new_capacity elements
+    void reserve(size_t new_capacity) {
+        if (new_capacity <= capacity)
+            return;
+        T *new_data = allocate(new_capacity);
+        for (size_t i = 0; i < size; ++i) {
+            new (new_data + i) T(std::move(data[i]));
+            data[i].~T();
+        }
+        deallocate(data, capacity);
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+    void mypush(const T &value) {
+        if (size == capacity) {
+            // value may be one of our elements, copy it before they move
+            T tmp(value);
+            reserve(capacity * 2); // first spill goes from N to 2N
+            new (data + size) T(std::move(tmp));
+        } else {
+            new (data + size) T(value);
+        }
+        ++size;
+    }
+
+    // Pop the last element
+    void mypop() {
+        if (size == 0)
+            return;
+        data[size - 1].~T();
+        --size;
+    }
+
+    T &operator[](size_t index) { return data[index]; }
+    const T &operator[](size_t index) const { return data[index]; }
+
+    void myprint() {
+        for (size_t i = 0; i < size; ++i)
+            std::cout << data[i] << " ";
+    }
+
+    // Destroys elements but keeps whatever buffer we have
+    void clear() {
+        for (size_t i = 0; i < size; ++i)
+            data[i].~T();
+        size = 0;
+    }
+
+    iterator begin() { return iterator(data); }
+    iterator end() { return iterator(data + size); }
+    const_iterator begin() const { return const_iterator(data); }
+    const_iterator end() const { return const_iterator(data + size); }
+
+    ~small_vector() {
+        clear();
+        deallocate(data, capacity);
+    }
+};
@@ -0,0 +1,81 @@
+#include "myvector.hpp"
+#include "small_vector.hpp"
+#include "tracking_allocator.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Short per-message vectors: build a vector of k ints, read it, destroy it,
+// many times over. myvector vs small_vector<int, 8>.
+// ns is timed with the default allocators (myvector<int> then grows with
+// realloc). The allocation counts come from a second pass of the same loop
+// with each container on a TrackingAllocator: allocs is allocate() calls
+// per vector, ints the elements TrackingAllocator saw allocated per vector.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+static ull g_allocate_calls = 0;
+
+// TrackingAllocator counts elements; this also counts the calls
+template <typename T> struct CountingAllocator : TrackingAllocator<T> {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+
+    T *allocate(size_t n) {
+        ++g_allocate_calls;
+        return TrackingAllocator<T>::allocate(n);
+    }
+};
+
+volatile int sink;
+
+struct result {
+    double ns_per_vector;
+    double allocs_per_vector;
+    double ints_per_vector;
+};
+
+template <typename Vec> void fill(size_t k, size_t rounds) {
+    for (size_t r = 0; r < rounds; ++r) {
+        Vec v;
+        for (size_t i = 0; i < k; ++i)
+            v.mypush((int)(r + i));
+        sink = v[k - 1];
+    }
+}
+
+template <typename Vec, typename CountedVec> result run(size_t k, size_t rounds) {
+    auto start_time = steady_clock::now();
+    fill<Vec>(k, rounds);
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+
+    ull calls_before = g_allocate_calls;
+    ull ints_before = TrackingAllocator<int>().get_allocations();
+    fill<CountedVec>(k, rounds);
+    return {(double)dur.count() / rounds,
+            (double)(g_allocate_calls - calls_before) / rounds,
+            (double)(TrackingAllocator<int>().get_allocations() - ints_before) /
+                rounds};
+}
+
+int main(int argc, char **argv) {
+    size_t rounds = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 2000000;
+    cout << "vectors per size = " << rounds << ", inline N = 8\n\n";
+    cout << "k     myvector ns  allocs  ints    small_vector ns  allocs  ints\n";
+    for (size_t k = 1; k <= 32; k *= 2) {
+        result a = run<myvector<int>, myvector<int, CountingAllocator<int>>>(
+            k, rounds);
+        result b = run<small_vector<int, 8>,
+                       small_vector<int, 8, CountingAllocator<int>>>(k, rounds);
+        cout << k << "\t" << a.ns_per_vector << "\t" << a.allocs_per_vector
+             << "\t" << a.ints_per_vector << "\t  " << b.ns_per_vector
+             << "\t\t   " << b.allocs_per_vector << "\t" << b.ints_per_vector
+             << "\n";
+    }
+    return 0;
+}
@@ -1,67 +1,14 @@
+#include "circular_queue.hpp"
+#include "market_data_tick.hpp"
+#include "myvector.hpp"
+#include "tracking_allocator.hpp"
 #include <iostream>     
+#include <cstdint>
 #include <memory>      
+#include <string>
+#include <thread>
 #include <vector>      
 
-// ==========================
-// Custom Allocator Template
-// ==========================
-
-template<class T>
-class TrackingAllocator
-{
-public:
-    // Standard typedefs required by allocator-aware containers (like std::vector)
-    using value_type = T;                    // The type this allocator allocates
-    using pointer = T*;                      // Pointer to T
-    using const_pointer = const T*;          // Pointer to const T
-    using size_type = size_t;               // Type used for sizes
-
-    // Default constructor — no initialization needed
-    TrackingAllocator() = default;
-
-    // Copy constructor template: allows copying from allocator of a different type U
-    // Required for allocator rebind in containers like std::vector
-    template<class U>
-    TrackingAllocator(const TrackingAllocator<U> &other) {}
-
-    // Destructor — nothing specific to clean up
-    ~TrackingAllocator() = default;
-
-    // Allocation function used by STL containers (e.g., vector)
-    pointer allocate(size_type numObjects)
-    {
-        // Increase the static allocation counter by number of elements allocated
-        mAllocations += numObjects;
-
-        // Allocate raw uninitialized memory for numObjects of type T
-        // operator new returns a void*, which is cast to T*
-        return static_cast<pointer>(operator new(sizeof(T) * numObjects));
-    }
-
-    // Deallocation function — releases the raw memory allocated earlier
-    void deallocate(pointer p, size_type numObjects)
-    {
-        // Standard operator delete used to free the memory
-        // numObjects is unused here, but is part of the allocator interface
-        operator delete(p);
-    }
-
-    // Accessor to the current number of allocations made
-    size_type get_allocations() const
-    {
-        return mAllocations;
-    }
-
-private:
-    // Static counter shared across all instances of TrackingAllocator<T>
-    // This allows us to count total allocations for the given type T
-    static size_type mAllocations;
-};
-
-// Define the static member outside the class
-template<class T>
-typename TrackingAllocator<T>::size_type TrackingAllocator<T>::mAllocations = 0;
-
 int main()
 {
     // Create a std::vector of 5 integers using our custom allocator
@@ -74,5 +21,66 @@ int main()
     // get_allocations() returns the static counter for how many elements were allocated
     std::cout << v.get_allocator().get_allocations() << std::endl;
 
+    // Our own containers take the allocator the same way. Counters are per
+    // element type, so use a type the vector above doesn't
+    myvector<long, TrackingAllocator<long>> mv;
+    mv.reserve(8);
+    for (long i = 0; i < 20; ++i)
+        mv.mypush(i); // grows 8 -> 16 -> 32
+    std::cout << mv.get_allocator().get_allocations() << std::endl; // 56
+
+    cqueue<short, TrackingAllocator<short>> q;
+    for (short i = 0; i < 5; ++i)
+        q.cadd(i); // grows 1 -> 2 -> 4 -> 8
+    std::cout << q.get_allocator().get_allocations() << std::endl; // 15
+
+    // Over-aligned types like MDT get aligned storage
+    myvector<MDT, TrackingAllocator<MDT>> history;
+    history.reserve(3);
+    std::cout << history.get_allocator().get_allocations() << " "
+              << (reinterpret_cast<uintptr_t>(history.data) % alignof(MDT))
+              << std::endl; // 3 0
+
+    // ProfilingAllocator counts bytes, frees and peak per tag as well, from
+    // any thread. Four threads share the "book" tag
+    AllocationStats &book = AllocationProfiler::instance().tag("book");
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+        workers.emplace_back([&book] {
+            for (int round = 0; round < 100; ++round) {
+                myvector<double, ProfilingAllocator<double>> levels{ProfilingAllocator<double>(book)};
+                levels.reserve(4);
+                for (int i = 0; i < 10; ++i)
+                    levels.mypush(i); // 4 -> 8 -> 16 doubles
+            }
+        });
+    for (std::thread &w : workers)
+        w.join();
+    std::cout << book.get_allocations() << " " << book.get_deallocations() << " "
+              << book.get_bytes_allocated() << " " << book.get_bytes_in_use()
+              << std::endl; // 1200 1200 89600 0
+
+    // Or per callsite, with a size histogram: 32, 64 and 128-byte buffers
+    std::vector<int, ProfilingAllocator<int>> ids{ProfilingAllocator<int>(ALLOCATION_CALLSITE())};
+    for (int i = 0; i < 20; ++i)
+        ids.push_back(i); // 1, 2, 4, 8, 16, 32 ints
+    AllocationStats &site = ids.get_allocator().stats();
+    std::cout << site.get_histogram(AllocationStats::bucket(32)) << " "
+              << site.get_histogram(AllocationStats::bucket(128)) << " "
+              << site.get_peak_bytes() << std::endl; // 1 1 192
+
+    // Tags can be built at runtime (the profiler keeps its own copy of the
+    // name), and over-aligned types get aligned storage
+    std::string symbol = "BTCUSD";
+    std::vector<MDT, ProfilingAllocator<MDT>> ticks{
+        ProfilingAllocator<MDT>(("ticks_" + symbol).c_str())};
+    ticks.resize(3);
+    std::cout << AllocationProfiler::instance().tag("ticks_BTCUSD").get_bytes_in_use()
+              << " " << (reinterpret_cast<uintptr_t>(ticks.data()) % alignof(MDT))
+              << std::endl; // 192 0
+
+    // Dump every tag when the program ends
+    AllocationProfiler::instance().report_at_exit(std::cout);
+
     return 0;
 }
@@ -0,0 +1,370 @@
+#pragma once
+#include <atomic>      // for AllocationStats counters
+#include <cstddef>     // for size_t
+#include <cstring>     // for strcmp
+#include <memory>      // for std::unique_ptr
+#include <memory_resource> // for TrackingResource
+#include <mutex>       // for the profiler's tag registry
+#include <new>         // for operator new/delete
+#include <ostream>     // for AllocationProfiler::report
+#include <string>      // for AllocationStats tag names
+#include <type_traits> // for std::true_type
+#include <vector>
+
+// ==========================
+// Custom Allocator Template
+// ==========================
+
+template<class T>
+class TrackingAllocator
+{
+public:
+    // Standard typedefs required by allocator-aware containers (like std::vector)
+    using value_type = T;                    // The type this allocator allocates
+    using pointer = T*;                      // Pointer to T
+    using const_pointer = const T*;          // Pointer to const T
+    using size_type = size_t;               // Type used for sizes
+
+    // Default constructor — no initialization needed
+    TrackingAllocator() = default;
+
+    // Copy constructor template: allows copying from allocator of a different type U
+    // Required for allocator rebind in containers like std::vector
+    template<class U>
+    TrackingAllocator(const TrackingAllocator<U> &) {}
+
+    // Destructor — nothing specific to clean up
+    ~TrackingAllocator() = default;
+
+    // Allocation function used by STL containers (e.g., vector)
+    pointer allocate(size_type numObjects)
+    {
+        // Increase the static allocation counter by number of elements allocated
+        mAllocations += numObjects;
+
+        // Allocate raw uninitialized memory for numObjects of type T
+        // operator new returns a void*, which is cast to T*
+        if constexpr (over_aligned)
+            return static_cast<pointer>(operator new(sizeof(T) * numObjects, std::align_val_t(alignof(T))));
+        else
+            return static_cast<pointer>(operator new(sizeof(T) * numObjects));
+    }
+
+    // Deallocation function — releases the raw memory allocated earlier
+    void deallocate(pointer p, [[maybe_unused]] size_type numObjects)
+    {
+        // Matching operator delete used to free the memory
+        // numObjects is unused here, but is part of the allocator interface
+        if constexpr (over_aligned)
+            operator delete(p, std::align_val_t(alignof(T)));
+        else
+            operator delete(p);
+    }
+
+    // Accessor to the current number of allocations made
+    size_type get_allocations() const
+    {
+        return mAllocations;
+    }
+
+private:
+    // Types like MDT (alignas(64)) need the aligned operator new
+    static constexpr bool over_aligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    // Static counter shared across all instances of TrackingAllocator<T>
+    // This allows us to count total allocations for the given type T
+    static size_type mAllocations;
+};
+
+// Define the static member outside the class (inline so every file that
+// includes this header shares one counter per T)
+template<class T>
+inline typename TrackingAllocator<T>::size_type TrackingAllocator<T>::mAllocations = 0;
+
+// Stateless: any TrackingAllocator can free what another one allocated, so
+// containers may swap/move buffers between them freely
+template<class T, class U>
+bool operator==(const TrackingAllocator<T> &, const TrackingAllocator<U> &) { return true; }
+
+template<class T, class U>
+bool operator!=(const TrackingAllocator<T> &, const TrackingAllocator<U> &) { return false; }
+
+// ==========================
+// Tracking memory resource
+// ==========================
+
+// Counts what passes through to an upstream std::pmr::memory_resource
+// (the default resource unless given one), so pmr containers or a pool
+// resource can be measured the way TrackingAllocator measures std ones.
+// Counters are per resource and not synchronized, like the pmr pools.
+class TrackingResource : public std::pmr::memory_resource
+{
+public:
+    explicit TrackingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : mUpstream(upstream) {}
+
+    size_t get_allocations() const { return mAllocations; }
+    size_t get_deallocations() const { return mDeallocations; }
+    size_t get_bytes_allocated() const { return mBytesAllocated; }
+    size_t get_bytes_in_use() const { return mBytesAllocated - mBytesDeallocated; }
+
+    std::pmr::memory_resource *upstream() const { return mUpstream; }
+
+protected:
+    void *do_allocate(size_t bytes, size_t align) override
+    {
+        void *p = mUpstream->allocate(bytes, align);
+        ++mAllocations;
+        mBytesAllocated += bytes;
+        return p;
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t align) override
+    {
+        ++mDeallocations;
+        mBytesDeallocated += bytes;
+        mUpstream->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource *mUpstream;
+    size_t mAllocations = 0;
+    size_t mDeallocations = 0;
+    size_t mBytesAllocated = 0;
+    size_t mBytesDeallocated = 0;
+};
+
+// ==========================
+// Allocation profiler
+// ==========================
+
+// Counters for one tag (a container, a subsystem or a callsite). All of
+// them are relaxed atomics, so any number of threads can allocate through
+// the same tag; the numbers are exact once those threads are done, and a
+// report taken while they run may be off by the allocations in flight.
+// Histogram bucket k counts requests of (2^(k-1), 2^k] bytes, bucket 0
+// the empty ones.
+class AllocationStats
+{
+public:
+    static constexpr size_t histogram_buckets = 65;
+
+    // Keeps its own copy of the name, so tags can be built from temporaries
+    explicit AllocationStats(const char *tag) : mTag(tag) {}
+
+    AllocationStats(const AllocationStats &) = delete;
+    AllocationStats &operator=(const AllocationStats &) = delete;
+
+    void record_allocation(size_t bytes)
+    {
+        mAllocations.fetch_add(1, std::memory_order_relaxed);
+        mBytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+        mHistogram[bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+        size_t live = mBytesLive.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = mPeakBytes.load(std::memory_order_relaxed);
+        while (live > peak &&
+               !mPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+    }
+
+    void record_deallocation(size_t bytes)
+    {
+        mDeallocations.fetch_add(1, std::memory_order_relaxed);
+        mBytesLive.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    // Start a new measurement window: zero everything, the high-water mark
+    // restarts at what is live now
+    void reset()
+    {
+        mAllocations.store(0, std::memory_order_relaxed);
+        mDeallocations.store(0, std::memory_order_relaxed);
+        mBytesAllocated.store(0, std::memory_order_relaxed);
+        mPeakBytes.store(mBytesLive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        for (std::atomic<size_t> &b : mHistogram)
+            b.store(0, std::memory_order_relaxed);
+    }
+
+    const char *tag() const { return mTag.c_str(); }
+    size_t get_allocations() const { return mAllocations.load(std::memory_order_relaxed); }
+    size_t get_deallocations() const { return mDeallocations.load(std::memory_order_relaxed); }
+    size_t get_bytes_allocated() const { return mBytesAllocated.load(std::memory_order_relaxed); }
+    size_t get_bytes_in_use() const { return mBytesLive.load(std::memory_order_relaxed); }
+    size_t get_peak_bytes() const { return mPeakBytes.load(std::memory_order_relaxed); }
+    size_t get_histogram(size_t b) const { return mHistogram[b].load(std::memory_order_relaxed); }
+
+    // Histogram bucket of a request size: 0 for 0 bytes, else ceil(log2) + 1
+    static size_t bucket(size_t bytes)
+    {
+        return bytes <= 1 ? bytes : 64 - __builtin_clzll(bytes - 1) + 1;
+    }
+
+    // Largest size counted in bucket b (0, 1, 2, 4, ...)
+    static size_t bucket_limit(size_t b) { return b == 0 ? 0 : size_t(1) << (b - 1); }
+
+    void report(std::ostream &os) const
+    {
+        os << mTag << ": " << get_allocations() << " allocs, " << get_deallocations()
+           << " frees, " << get_bytes_allocated() << " bytes, " << get_bytes_in_use()
+           << " live, " << get_peak_bytes() << " peak\n";
+        for (size_t b = 0; b < histogram_buckets; ++b)
+            if (size_t n = get_histogram(b))
+                os << "    <= " << bucket_limit(b) << " B: " << n << "\n";
+    }
+
+private:
+    std::string mTag;
+    std::atomic<size_t> mAllocations{0};
+    std::atomic<size_t> mDeallocations{0};
+    std::atomic<size_t> mBytesAllocated{0};
+    std::atomic<size_t> mBytesLive{0};
+    std::atomic<size_t> mPeakBytes{0};
+    std::atomic<size_t> mHistogram[histogram_buckets] = {};
+};
+
+// Process-wide registry of tags. tag() hands out one AllocationStats per
+// name that lives until exit, so keep the reference (a static, a member)
+// rather than looking it up per allocation; ALLOCATION_CALLSITE() does
+// that for a source line.
+class AllocationProfiler
+{
+public:
+    static AllocationProfiler &instance()
+    {
+        static AllocationProfiler profiler;
+        return profiler;
+    }
+
+    AllocationStats &tag(const char *name)
+    {
+        std::lock_guard<std::mutex> locker(mLock);
+        for (const std::unique_ptr<AllocationStats> &s : mTags)
+            if (std::strcmp(s->tag(), name) == 0)
+                return *s;
+        mTags.emplace_back(new AllocationStats(name));
+        return *mTags.back();
+    }
+
+    // Every tag that allocated anything, in registration order
+    void report(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> locker(mLock);
+        os << "===== allocation profile =====\n";
+        for (const std::unique_ptr<AllocationStats> &s : mTags)
+            if (s->get_allocations() || s->get_bytes_in_use())
+                s->report(os);
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> locker(mLock);
+        for (const std::unique_ptr<AllocationStats> &s : mTags)
+            s->reset();
+    }
+
+    // Print report() to os when the program exits
+    void report_at_exit(std::ostream &os)
+    {
+        std::lock_guard<std::mutex> locker(mLock);
+        mExitStream = &os;
+    }
+
+    ~AllocationProfiler()
+    {
+        if (mExitStream)
+            report(*mExitStream);
+    }
+
+private:
+    AllocationProfiler() = default;
+
+    std::mutex mLock;
+    std::vector<std::unique_ptr<AllocationStats>> mTags;
+    std::ostream *mExitStream = nullptr;
+};
+
+#define ALLOCATION_STRINGIFY_(x) #x
+#define ALLOCATION_STRINGIFY(x) ALLOCATION_STRINGIFY_(x)
+
+// The stats of the line this appears on ("file.cpp:42"), looked up once
+#define ALLOCATION_CALLSITE()                                                      \
+    ([]() -> AllocationStats & {                                                   \
+        static AllocationStats &stats = AllocationProfiler::instance().tag(        \
+            __FILE__ ":" ALLOCATION_STRINGIFY(__LINE__));                          \
+        return stats;                                                              \
+    }())
+
+// TrackingAllocator that counts into a tag: calls, bytes, frees, live
+// bytes, high-water mark and sizes, thread-safe. Default-constructed ones
+// count into "untagged". The tag travels with the memory (all three
+// propagate traits are set), so a moved or swapped container keeps
+// charging the tag that allocated its buffer.
+template<class T>
+class ProfilingAllocator
+{
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using size_type = size_t;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ProfilingAllocator() : mStats(&AllocationProfiler::instance().tag("untagged")) {}
+
+    explicit ProfilingAllocator(AllocationStats &stats) : mStats(&stats) {}
+
+    explicit ProfilingAllocator(const char *tag)
+        : mStats(&AllocationProfiler::instance().tag(tag)) {}
+
+    template<class U>
+    ProfilingAllocator(const ProfilingAllocator<U> &other) : mStats(&other.stats()) {}
+
+    pointer allocate(size_type numObjects)
+    {
+        pointer p;
+        if constexpr (over_aligned)
+            p = static_cast<pointer>(operator new(sizeof(T) * numObjects, std::align_val_t(alignof(T))));
+        else
+            p = static_cast<pointer>(operator new(sizeof(T) * numObjects));
+        mStats->record_allocation(sizeof(T) * numObjects);
+        return p;
+    }
+
+    void deallocate(pointer p, size_type numObjects)
+    {
+        mStats->record_deallocation(sizeof(T) * numObjects);
+        if constexpr (over_aligned)
+            operator delete(p, std::align_val_t(alignof(T)));
+        else
+            operator delete(p);
+    }
+
+    AllocationStats &stats() const { return *mStats; }
+
+private:
+    // Types like MDT (alignas(64)) need the aligned operator new
+    static constexpr bool over_aligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    AllocationStats *mStats;
+};
+
+// Memory is interchangeable, but only equal allocators keep the counters
+// of a tag balanced
+template<class T, class U>
+bool operator==(const ProfilingAllocator<T> &a, const ProfilingAllocator<U> &b)
+{
+    return &a.stats() == &b.stats();
+}
+
+template<class T, class U>
+bool operator!=(const ProfilingAllocator<T> &a, const ProfilingAllocator<U> &b)
+{
+    return !(a == b);
+}
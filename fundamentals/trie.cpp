@@ -1,47 +1,7 @@
+#include "trie.hpp"
 #include <iostream>
-#include <string>
-#include <vector>
 #include <algorithm>
 
-struct trie {
-    std::vector<trie*> dic = std::vector<trie*>(26, nullptr);  
-    bool flag = false; 
-
-};
-
-void insert(trie* root, const std::string& s) {
-    trie* node = root;
-    for (char c : s) {
-        int index = c - 'a';
-        if (node->dic[index] == nullptr) {
-            node->dic[index] = new trie();
-        }
-        node = node->dic[index];
-    }
-    node->flag = true;
-}
-
-bool search (trie* root, const std::string& s){
-    trie* node = root;
-
-    for(char c : s){
-        int index = c - 'a';
-        if(node->dic[index]==nullptr){
-            return false;
-        }
-        node = node->dic[index];
-    }
-
-    return node->flag;
-}
-
-bool starts_with(trie* root, char c) {
-    int index = c - 'a';
-    if (index < 0 || index >= 26) return false;
-    return root->dic[index] != nullptr;
-}
-
-
 int main(){
     trie* root = new trie();
 
@@ -0,0 +1,48 @@
+#pragma once
+#include <string>
+#include <vector>
+
+struct trie {
+    std::vector<trie*> dic = std::vector<trie*>(26, nullptr);  
+    bool flag = false; 
+
+};
+
+inline void insert(trie* root, const std::string& s) {
+    trie* node = root;
+    for (char c : s) {
+        int index = c - 'a';
+        if (node->dic[index] == nullptr) {
+            node->dic[index] = new trie();
+        }
+        node = node->dic[index];
+    }
+    node->flag = true;
+}
+
+inline bool search (trie* root, const std::string& s){
+    trie* node = root;
+
+    for(char c : s){
+        int index = c - 'a';
+        if(node->dic[index]==nullptr){
+            return false;
+        }
+        node = node->dic[index];
+    }
+
+    return node->flag;
+}
+
+inline bool starts_with(trie* root, char c) {
+    int index = c - 'a';
+    if (index < 0 || index >= 26) return false;
+    return root->dic[index] != nullptr;
+}
+
+// Free root and everything below it
+inline void free_trie(trie* root) {
+    for (trie* child : root->dic)
+        if (child) free_trie(child);
+    delete root;
+}
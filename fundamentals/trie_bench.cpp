@@ -0,0 +1,136 @@
+#include "compact_trie.hpp"
+#include "trie.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <malloc.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// Dictionary of N words (default 1M) built the way real ones are: a
+// random stem, an optional prefix (un-, re-, ...) and an optional suffix
+// (-s, -ing, -ation, ...). Per trie:
+// - bytes/key: heap growth while inserting, from mallinfo2
+// - insert ns: per insert, in dictionary order
+// - hit ns: search() for every word in shuffled order
+// - miss ns: search() for words with a changed last letter
+// compact_trie is measured again after compact() lays it out depth-first.
+// The pointer trie (trie.hpp) needs ~270 bytes per node, so it is skipped
+// above max_pointer_words (default 2M, second argument) to fit in memory.
+
+using namespace std;
+using namespace chrono;
+
+vector<string> make_dictionary(size_t n) {
+    static const char *prefixes[] = {"",   "un",  "re",    "pre",  "dis",
+                                     "in", "over", "mis",  "non",  "sub",
+                                     "inter", "counter"};
+    static const char *suffixes[] = {"",     "s",    "ed",    "ing",  "er",
+                                     "ers",  "ly",   "ness",  "ation", "ations",
+                                     "able", "ment", "ments", "ful",  "less",
+                                     "ity",  "ize",  "ized",  "izing", "ist",
+                                     "ists", "ism",  "ive",   "ous",  "est"};
+    const size_t np = size(prefixes), ns = size(suffixes);
+    mt19937_64 rng(11);
+    size_t stems = n / (np * ns) + 1;
+    vector<string> stem(stems * 2); // oversample, some combos collide
+    for (string &s : stem) {
+        s.resize(3 + rng() % 6);
+        for (char &ch : s)
+            ch = "etaoinshrdlcumwfgypbvkjxqz"[min<size_t>(rng() % 26, rng() % 26)];
+    }
+    size_t total = stem.size() * np * ns, step = 1000003; // prime, co-prime
+    while (total % step == 0)
+        step += 2;
+    vector<string> words;
+    words.reserve(n);
+    for (size_t i = 0; words.size() < n && i < total; ++i) {
+        size_t k = (i * step) % total;
+        words.push_back(string(prefixes[k % np]) + stem[k / np / ns] +
+                        suffixes[k / np % ns]);
+    }
+    return words;
+}
+
+size_t heap_bytes() {
+    struct mallinfo2 m = mallinfo2();
+    return m.uordblks + m.hblkhd;
+}
+
+template <typename Search>
+void run_search(const string &name, const vector<string> &hits,
+                const vector<string> &misses, Search search_word) {
+    if (!name.empty())
+        cout << name << "\t-\t\t-\t\t";
+    size_t found = 0;
+    auto start_time = steady_clock::now();
+    for (const string &w : hits)
+        found += search_word(w);
+    double hit_ns = (double)duration_cast<nanoseconds>(steady_clock::now() - start_time)
+                         .count() / hits.size();
+    start_time = steady_clock::now();
+    for (const string &w : misses)
+        found += search_word(w);
+    double miss_ns = (double)duration_cast<nanoseconds>(steady_clock::now() - start_time)
+                         .count() / misses.size();
+
+    cout << hit_ns << "\t" << miss_ns << "\t(" << found << " found)\n";
+}
+
+template <typename Insert, typename Search>
+void run(const string &name, const vector<string> &words,
+         const vector<string> &hits, const vector<string> &misses,
+         Insert insert_word, Search search_word) {
+    size_t before = heap_bytes();
+    auto start_time = steady_clock::now();
+    for (const string &w : words)
+        insert_word(w);
+    double insert_ns = (double)duration_cast<nanoseconds>(steady_clock::now() - start_time)
+                         .count() / words.size();
+    double bytes = (double)(heap_bytes() - before) / words.size();
+
+    cout << name << "\t" << bytes << "\t\t" << insert_ns << "\t\t";
+    run_search("", hits, misses, search_word);
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? stoull(argv[1]) : 1000000;
+    size_t max_pointer_words = (argc > 2) ? stoull(argv[2]) : 2000000;
+
+    vector<string> words = make_dictionary(n);
+    vector<string> hits = words;
+    shuffle(hits.begin(), hits.end(), mt19937(5));
+    vector<string> misses = hits;
+    for (string &w : misses)
+        w.back() = w.back() == 'q' ? 'j' : 'q';
+    size_t chars = 0;
+    for (const string &w : words)
+        chars += w.size();
+    cout << "words = " << words.size() << ", avg length = "
+         << (double)chars / words.size() << "\n\n";
+    cout << "trie\t\tbytes/key\tinsert ns\thit ns\tmiss ns\n";
+
+    if (n <= max_pointer_words) {
+        trie *root = new trie();
+        run("pointer trie", words, hits, misses,
+            [&](const string &w) { insert(root, w); },
+            [&](const string &w) { return search(root, w); });
+        free_trie(root);
+    } else {
+        cout << "pointer trie\tskipped (> " << max_pointer_words << " words)\n";
+    }
+    {
+        compact_trie compact;
+        run("compact_trie", words, hits, misses,
+            [&](const string &w) { compact.insert(w); },
+            [&](const string &w) { return compact.search(w); });
+        compact.compact();
+        run_search("  compact()ed", hits, misses,
+                   [&](const string &w) { return compact.search(w); });
+        cout << "\t\t(" << compact.size() << " keys, "
+             << compact.memory_bytes() / (1 << 20) << " MB pool, "
+             << compact.free_bytes() / (1 << 10) << " KB on free lists)\n";
+    }
+    return 0;
+}
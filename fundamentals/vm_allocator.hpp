@@ -0,0 +1,146 @@
+#pragma once
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uintptr_t
+#include <new>       // for std::bad_alloc
+#include <sys/mman.h> // for mmap, mprotect, madvise
+#include <unistd.h>  // for sysconf
+
+/*
+    Allocator for very large myvectors (e.g. a full day of MDT history)
+    that never copies on growth.
+
+    allocate() reserves reserve_bytes of address space with PROT_NONE and
+    only makes the first n elements' worth readable/writable (rounded up to
+    the commit granularity). When myvector grows it calls resize_in_place(),
+    which just opens up more of the reservation with mprotect, so the
+    elements stay where they are and no old page is touched again. Pages
+    are still only backed by memory once they're written.
+
+    page_mode::transparent aligns the reservation to 2 MiB and asks for
+    transparent huge pages (madvise), page_mode::explicit_huge maps from
+    the hugetlbfs pool (MAP_HUGETLB, needs vm.nr_hugepages) and falls back
+    to transparent if the pool can't back the reservation, page_mode::small
+    forces 4 KiB pages for comparison.
+
+    Requests bigger than reserve_bytes still work but get their own exact
+    reservation, so growing past it falls back to allocate + copy.
+*/
+
+enum class page_mode { small, transparent, explicit_huge };
+
+constexpr size_t huge_page_size = size_t(2) << 20;
+
+template <typename T> struct vm_allocator {
+    using value_type = T;
+
+    size_t reserve_bytes;
+    page_mode mode;
+
+    explicit vm_allocator(size_t reserve = size_t(64) << 30,
+                          page_mode m = page_mode::transparent)
+        : reserve_bytes(round_up(reserve, huge_page_size)), mode(m) {}
+
+    template <typename U>
+    vm_allocator(const vm_allocator<U> &other)
+        : reserve_bytes(other.reserve_bytes), mode(other.mode) {}
+
+    static size_t round_up(size_t bytes, size_t to) {
+        return (bytes + to - 1) / to * to;
+    }
+
+    // Commits happen in huge-page steps unless we're on small pages, so a
+    // THP never gets split by a protection boundary
+    size_t granularity() const {
+        return mode == page_mode::small ? (size_t)sysconf(_SC_PAGESIZE)
+                                        : huge_page_size;
+    }
+
+    // Size of the reservation behind an allocation of bytes
+    size_t reservation(size_t bytes) const {
+        return bytes <= reserve_bytes ? reserve_bytes
+                                      : round_up(bytes, huge_page_size);
+    }
+
+    T *allocate(size_t n) {
+        size_t length = reservation(n * sizeof(T));
+        char *base = nullptr;
+        if (mode == page_mode::explicit_huge) {
+            // No MAP_NORESERVE here: the pool pages are reserved up front,
+            // otherwise running out of them later would be a SIGBUS
+            void *p = mmap(nullptr, length, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED)
+                base = static_cast<char *>(p);
+        }
+        if (!base) {
+            // Over-reserve by one huge page and trim, so the usable part
+            // starts on a 2 MiB boundary and can be backed by THPs
+            size_t padded = length + huge_page_size;
+            void *p = mmap(nullptr, padded, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            char *raw = static_cast<char *>(p);
+            base = reinterpret_cast<char *>(
+                round_up(reinterpret_cast<uintptr_t>(raw), huge_page_size));
+            if (base != raw)
+                munmap(raw, base - raw);
+            munmap(base + length, raw + padded - (base + length));
+            madvise(base, length,
+                    mode == page_mode::small ? MADV_NOHUGEPAGE
+                                             : MADV_HUGEPAGE);
+        }
+        if (!commit(base, 0, n * sizeof(T))) {
+            munmap(base, length);
+            throw std::bad_alloc();
+        }
+        return reinterpret_cast<T *>(base);
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (p)
+            munmap(p, reservation(n * sizeof(T)));
+    }
+
+    // Make [old_bytes, new_bytes) of the reservation at base usable
+    bool commit(char *base, size_t old_bytes, size_t new_bytes) {
+        size_t from = round_up(old_bytes, granularity());
+        size_t to = round_up(new_bytes, granularity());
+        if (to <= from)
+            return true;
+        return mprotect(base + from, to - from, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    /*
+        Grow or shrink the allocation at p from old_n to new_n elements
+        without moving it. Growing within the reservation always works,
+        shrinking gives the tail's memory back to the OS. false means the
+        caller has to allocate + copy (new_n past the reservation).
+    */
+    bool resize_in_place(T *p, size_t old_n, size_t new_n) {
+        char *base = reinterpret_cast<char *>(p);
+        size_t reserved = reservation(old_n * sizeof(T));
+        if (new_n * sizeof(T) > reserved ||
+            reservation(new_n * sizeof(T)) != reserved)
+            return false;
+        if (new_n >= old_n)
+            return commit(base, old_n * sizeof(T), new_n * sizeof(T));
+        size_t keep = round_up(new_n * sizeof(T), granularity());
+        size_t had = round_up(old_n * sizeof(T), granularity());
+        if (had > keep) {
+            madvise(base + keep, had - keep, MADV_DONTNEED);
+            mprotect(base + keep, had - keep, PROT_NONE);
+        }
+        return true;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const vm_allocator<T> &a, const vm_allocator<U> &b) {
+    return a.reserve_bytes == b.reserve_bytes && a.mode == b.mode;
+}
+
+template <typename T, typename U>
+bool operator!=(const vm_allocator<T> &a, const vm_allocator<U> &b) {
+    return !(a == b);
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../fundamentals/circular_queue.hpp"
+
+// Market data thread -> strategy thread handoff:
+// mutex + condition_variable + deque (like 15_multithreading.cpp)
+// vs the lock-free spsc_cqueue. Every item carries the time it was produced,
+// the consumer records now - produced to get the handoff latency.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+constexpr size_t queue_capacity = 1024;
+
+ull now_ns() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct result {
+    double ops_per_sec;
+    ull p50_ns;
+    ull p99_ns;
+};
+
+result summarize(vector<ull> &latencies, ull elapsed_ns) {
+    result r;
+    r.ops_per_sec = latencies.size() * 1e9 / elapsed_ns;
+    size_t p50 = latencies.size() / 2;
+    size_t p99 = latencies.size() * 99 / 100;
+    nth_element(latencies.begin(), latencies.begin() + p50, latencies.end());
+    r.p50_ns = latencies[p50];
+    nth_element(latencies.begin(), latencies.begin() + p99, latencies.end());
+    r.p99_ns = latencies[p99];
+    return r;
+}
+
+// Same shape as 15_multithreading.cpp minus the printing under the lock
+result run_mutex_pipeline(size_t count) {
+    mutex m;
+    condition_variable cv;
+    deque<ull> buffer;
+    vector<ull> latencies(count);
+
+    ull begin = now_ns();
+    thread producer([&] {
+        for (size_t i = 0; i < count; ++i) {
+            unique_lock<mutex> locker(m);
+            cv.wait(locker, [&] { return buffer.size() < queue_capacity; });
+            buffer.push_back(now_ns());
+            locker.unlock();
+            cv.notify_all();
+        }
+    });
+    thread consumer([&] {
+        for (size_t i = 0; i < count; ++i) {
+            unique_lock<mutex> locker(m);
+            cv.wait(locker, [&] { return !buffer.empty(); });
+            ull produced = buffer.front();
+            buffer.pop_front();
+            locker.unlock();
+            cv.notify_all();
+            latencies[i] = now_ns() - produced;
+        }
+    });
+    producer.join();
+    consumer.join();
+    return summarize(latencies, now_ns() - begin);
+}
+
+result run_spsc_pipeline(size_t count) {
+    spsc_cqueue<ull> pipe(queue_capacity);
+    vector<ull> latencies(count);
+
+    ull begin = now_ns();
+    thread producer([&] {
+        for (size_t i = 0; i < count; ++i)
+            pipe.cadd(now_ns());
+    });
+    thread consumer([&] {
+        ull produced = 0;
+        for (size_t i = 0; i < count; ++i) {
+            pipe.cpop(produced);
+            latencies[i] = now_ns() - produced;
+        }
+    });
+    producer.join();
+    consumer.join();
+    return summarize(latencies, now_ns() - begin);
+}
+
+void print(const char *name, const result &r) {
+    cout << name << "\n";
+    cout << "ops/sec  = " << (ull)r.ops_per_sec << "\n";
+    cout << "p50      = " << r.p50_ns << " ns\n";
+    cout << "p99      = " << r.p99_ns << " ns\n" << endl;
+}
+
+int main(int argc, char **argv) {
+    size_t count = (argc > 1) ? stoull(argv[1]) : 2000000;
+    cout << "handoffs = " << count << ", capacity = " << queue_capacity
+         << ", cores = " << thread::hardware_concurrency() << "\n\n";
+
+    print("mutex + condition_variable + deque", run_mutex_pipeline(count));
+    print("spsc_cqueue (lock-free)", run_spsc_pipeline(count));
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <semaphore.h>
+#include <thread>
+#include <vector>
+
+#include "../fundamentals/circular_queue.hpp"
+
+// N producers -> N consumers, every item consumed exactly once:
+// mutex + condition_variable + deque (15_multithreading.cpp)
+// vs three POSIX semaphores + deque (16_multithreading.cpp)
+// vs the lock-free mpmc_cqueue.
+// No printing under the lock, each consumer sums what it got so we can check
+// nothing was lost or duplicated.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+constexpr unsigned int max_buffer_size = 1024;
+
+struct result {
+    double ops_per_sec;
+    bool ok;
+};
+
+// Runs producers/consumers threads around push/pop and times them
+template <typename Push, typename Pop>
+result run(int threads, size_t per_producer, Push push, Pop pop) {
+    atomic<ull> sum{0};
+    vector<thread> workers;
+
+    auto start_time = steady_clock::now();
+    for (int p = 0; p < threads; ++p)
+        workers.emplace_back([&] {
+            for (size_t i = 1; i <= per_producer; ++i)
+                push((ull)i);
+        });
+    for (int c = 0; c < threads; ++c)
+        workers.emplace_back([&] {
+            ull local = 0;
+            for (size_t i = 0; i < per_producer; ++i)
+                local += pop();
+            sum += local;
+        });
+    for (thread &w : workers)
+        w.join();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+
+    ull total = (ull)threads * per_producer;
+    ull expected = (ull)threads * per_producer * (per_producer + 1) / 2;
+    return {total * 1e9 / dur.count(), sum.load() == expected};
+}
+
+result run_mutex(int threads, size_t per_producer) {
+    mutex m;
+    condition_variable cv;
+    deque<ull> buffer;
+    return run(
+        threads, per_producer,
+        [&](ull val) {
+            unique_lock<mutex> locker(m);
+            cv.wait(locker, [&] { return buffer.size() < max_buffer_size; });
+            buffer.push_back(val);
+            locker.unlock();
+            cv.notify_all();
+        },
+        [&] {
+            unique_lock<mutex> locker(m);
+            cv.wait(locker, [&] { return !buffer.empty(); });
+            ull val = buffer.back();
+            buffer.pop_back();
+            locker.unlock();
+            cv.notify_all();
+            return val;
+        });
+}
+
+result run_semaphore(int threads, size_t per_producer) {
+    deque<ull> buffer;
+    sem_t sem_empty, sem_full, sem_crit;
+    sem_init(&sem_empty, 0, max_buffer_size);
+    sem_init(&sem_full, 0, 0);
+    sem_init(&sem_crit, 0, 1);
+    result r = run(
+        threads, per_producer,
+        [&](ull val) {
+            sem_wait(&sem_empty);
+            sem_wait(&sem_crit);
+            buffer.push_back(val);
+            sem_post(&sem_crit);
+            sem_post(&sem_full);
+        },
+        [&] {
+            sem_wait(&sem_full);
+            sem_wait(&sem_crit);
+            ull val = buffer.back();
+            buffer.pop_back();
+            sem_post(&sem_crit);
+            sem_post(&sem_empty);
+            return val;
+        });
+    sem_destroy(&sem_empty);
+    sem_destroy(&sem_full);
+    sem_destroy(&sem_crit);
+    return r;
+}
+
+result run_mpmc(int threads, size_t per_producer) {
+    mpmc_cqueue<ull> q(max_buffer_size);
+    return run(
+        threads, per_producer, [&](ull val) { q.cadd(val); },
+        [&] {
+            ull val = 0;
+            q.cpop(val);
+            return val;
+        });
+}
+
+void print(const char *name, const result &r) {
+    cout << "  " << name << (ull)r.ops_per_sec << " ops/sec"
+         << (r.ok ? "" : "  (SUM MISMATCH)") << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t per_producer = (argc > 1) ? stoull(argv[1]) : 200000;
+    int max_threads = (argc > 2) ? stoi(argv[2])
+                                 : max(1u, thread::hardware_concurrency() / 2);
+    cout << "items per producer = " << per_producer
+         << ", capacity = " << max_buffer_size
+         << ", cores = " << thread::hardware_concurrency() << "\n\n";
+
+    for (int n = 1; n <= max_threads; n *= 2) {
+        cout << n << " producers / " << n << " consumers\n";
+        print("mutex + condvar : ", run_mutex(n, per_producer));
+        print("semaphores      : ", run_semaphore(n, per_producer));
+        print("mpmc_cqueue     : ", run_mpmc(n, per_producer));
+        cout << endl;
+    }
+    return 0;
+}
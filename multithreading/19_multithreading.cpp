@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <new> // for placement new
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../fundamentals/market_data_tick.hpp"
+#include "../fundamentals/shm_cqueue.hpp"
+
+// Feed handler process -> strategy process through shm_cqueue.
+// The parent creates the segment and publishes MDT ticks stamped with
+// steady_clock (CLOCK_MONOTONIC, same clock in both processes); the forked
+// child attaches by name like an unrelated process would and records
+// now - timestamp_ns for every tick it gets. The parent publishes only once
+// the child holds its cursor, so received + dropped == ticks.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+const string shm_name = "/mdt_feed_19";
+constexpr size_t ring_capacity = 4096;
+
+ull now_ns() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int run_strategy(size_t count, atomic<bool> &ready) {
+    shm_cqueue<MDT> feed = shm_cqueue<MDT>::attach(shm_name);
+    shm_cqueue<MDT>::reader cursor = feed.make_reader();
+    ready.store(true, memory_order_release);
+    vector<ull> latencies;
+    latencies.reserve(count);
+
+    MDT tick{};
+    while (cursor.pos < count) {
+        if (!feed.try_read(cursor, tick))
+            continue;
+        latencies.push_back(now_ns() - tick.timestamp_ns);
+    }
+
+    sort(latencies.begin(), latencies.end());
+    cout << "received = " << latencies.size() << ", dropped = "
+         << cursor.dropped << "\n";
+    if (!latencies.empty()) {
+        cout << "p50      = " << latencies[latencies.size() / 2] << " ns\n";
+        cout << "p99      = " << latencies[latencies.size() * 99 / 100]
+             << " ns\n";
+        cout << "max      = " << latencies.back() << " ns\n";
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    size_t count = (argc > 1) ? stoull(argv[1]) : 1000000;
+    ull gap_ns = (argc > 2) ? stoull(argv[2]) : 200; // pacing between ticks
+
+    shm_cqueue<MDT> feed = shm_cqueue<MDT>::create(shm_name, ring_capacity);
+    // Set by the child once it has its cursor; shared across the fork
+    void *flag = mmap(nullptr, sizeof(atomic<bool>), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (flag == MAP_FAILED) {
+        cerr << "mmap failed\n";
+        return 1;
+    }
+    atomic<bool> *ready = new (flag) atomic<bool>(false);
+    cout << "ticks = " << count << ", gap = " << gap_ns
+         << " ns, capacity = " << feed.capacity() << "\n"
+         << endl; // flush before fork so the child doesn't repeat it
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        feed.detach(); // drop the inherited mapping, attach like a stranger
+        return run_strategy(count, *ready);
+    }
+
+    // Don't publish until the strategy process has its cursor, and give up
+    // if it died before that (attach threw, ...)
+    while (!ready->load(memory_order_acquire)) {
+        if (waitpid(pid, nullptr, WNOHANG) == pid) {
+            cerr << "strategy process exited before attaching\n";
+            shm_cqueue<MDT>::unlink(shm_name);
+            return 1;
+        }
+    }
+
+    MDT tick{};
+    ull next = now_ns();
+    for (size_t i = 0; i < count; ++i) {
+        while (now_ns() < next)
+            ;
+        tick.last_price = 100.0 + (i & 15);
+        tick.timestamp_ns = now_ns();
+        feed.publish(tick);
+        next += gap_ns;
+    }
+
+    waitpid(pid, nullptr, 0);
+    shm_cqueue<MDT>::unlink(shm_name);
+    munmap(flag, sizeof(atomic<bool>));
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../fundamentals/circular_queue.hpp"
+#include "../fundamentals/market_data_tick.hpp"
+#include "../fundamentals/multicast_cqueue.hpp"
+
+// One feed thread, N stages that must all see every tick.
+// Fan-out: the feed copies each MDT into N separate spsc_cqueues.
+// Multicast: the feed writes each MDT once into multicast_cqueue and every
+// stage reads it through its own cursor, once per wait strategy.
+// Each stage sums timestamp_ns so we can check nobody missed a tick.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+constexpr size_t ring_capacity = 1024;
+
+struct result {
+    double ops_per_sec; // ticks published per second
+    bool ok;
+};
+
+result run_fanout(int stages, size_t count) {
+    vector<unique_ptr<spsc_cqueue<MDT>>> queues;
+    for (int s = 0; s < stages; ++s)
+        queues.emplace_back(new spsc_cqueue<MDT>(ring_capacity));
+    vector<ull> sums(stages * 8, 0); // stride 8 so sums don't share a line
+
+    auto start_time = steady_clock::now();
+    vector<thread> workers;
+    for (int s = 0; s < stages; ++s)
+        workers.emplace_back([&, s] {
+            MDT tick;
+            ull local = 0;
+            for (size_t i = 0; i < count; ++i) {
+                queues[s]->cpop(tick);
+                local += tick.timestamp_ns;
+            }
+            sums[s * 8] = local;
+        });
+    MDT tick{};
+    for (size_t i = 1; i <= count; ++i) {
+        tick.timestamp_ns = i;
+        for (int s = 0; s < stages; ++s)
+            queues[s]->cadd(tick); // one copy per stage
+    }
+    for (thread &w : workers)
+        w.join();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+
+    bool ok = true;
+    for (int s = 0; s < stages; ++s)
+        ok = ok && sums[s * 8] == (ull)count * (count + 1) / 2;
+    return {count * 1e9 / dur.count(), ok};
+}
+
+template <typename Wait> result run_multicast(int stages, size_t count) {
+    multicast_cqueue<MDT, Wait> ring(ring_capacity);
+    vector<typename multicast_cqueue<MDT, Wait>::consumer *> cursors;
+    for (int s = 0; s < stages; ++s)
+        cursors.push_back(&ring.add_consumer());
+    vector<ull> sums(stages * 8, 0);
+
+    auto start_time = steady_clock::now();
+    vector<thread> workers;
+    for (int s = 0; s < stages; ++s)
+        workers.emplace_back([&, s] {
+            ull local = 0;
+            size_t seen = 0;
+            while (seen < count)
+                seen += ring.consume(*cursors[s], [&](const MDT &tick) {
+                    local += tick.timestamp_ns;
+                });
+            sums[s * 8] = local;
+        });
+    MDT tick{};
+    for (size_t i = 1; i <= count; ++i) {
+        tick.timestamp_ns = i;
+        ring.publish(tick); // one copy, all stages read it
+    }
+    for (thread &w : workers)
+        w.join();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+
+    bool ok = true;
+    for (int s = 0; s < stages; ++s)
+        ok = ok && sums[s * 8] == (ull)count * (count + 1) / 2;
+    return {count * 1e9 / dur.count(), ok};
+}
+
+void print(const char *name, const result &r) {
+    cout << "  " << name << (ull)r.ops_per_sec << " ticks/sec"
+         << (r.ok ? "" : "  (SUM MISMATCH)") << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t count = (argc > 1) ? stoull(argv[1]) : 2000000;
+    int max_stages = (argc > 2) ? stoi(argv[2]) : 3;
+    bool spin = thread::hardware_concurrency() > (unsigned)max_stages;
+    cout << "ticks = " << count << ", capacity = " << ring_capacity
+         << ", cores = " << thread::hardware_concurrency() << "\n\n";
+
+    for (int stages = 1; stages <= max_stages; ++stages) {
+        cout << stages << " stage(s)\n";
+        print("fan-out into N spsc_cqueues : ", run_fanout(stages, count));
+        // Busy spinning with more threads than cores never finishes a slice
+        if (spin)
+            print("multicast, busy spin        : ",
+                  run_multicast<busy_spin_wait>(stages, count));
+        print("multicast, yield            : ",
+              run_multicast<yield_wait>(stages, count));
+        print("multicast, blocking         : ",
+              run_multicast<blocking_wait>(stages, count));
+        cout << endl;
+    }
+    return 0;
+}
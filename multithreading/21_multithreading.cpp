@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../fundamentals/concurrent_vector.hpp"
+#include "../fundamentals/market_data_tick.hpp"
+#include "../fundamentals/myvector.hpp"
+
+// N ingest threads appending MDT records into one shared vector:
+// myvector behind a mutex vs the lock-free concurrent_vector, from 1 thread
+// up to every core. A reader thread keeps indexing published records while
+// the writers run, and at the end every timestamp must be there exactly
+// once.
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+struct result {
+    double appends_per_sec;
+    bool ok;
+};
+
+// Runs the writers (thread t appends timestamps t, t + threads, ...) and
+// one reader around append/read, then checks the contents
+template <typename Append, typename Read, typename Check>
+result run(int threads, size_t per_thread, Append append, Read read,
+           Check check) {
+    vector<thread> writers;
+    atomic<bool> done{false};
+    thread reader([&] {
+        while (!done.load(memory_order_acquire))
+            read();
+    });
+
+    auto start_time = steady_clock::now();
+    for (int t = 0; t < threads; ++t)
+        writers.emplace_back([&, t] {
+            MDT tick{};
+            for (size_t i = 0; i < per_thread; ++i) {
+                tick.timestamp_ns = (ull)i * threads + t;
+                append(tick);
+            }
+        });
+    for (thread &w : writers)
+        w.join();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    done.store(true, memory_order_release);
+    reader.join();
+
+    ull total = (ull)threads * per_thread;
+    return {total * 1e9 / dur.count(), check(total)};
+}
+
+// Every timestamp 0 .. total - 1 appears exactly once
+template <typename Get> bool all_present(ull total, Get get) {
+    vector<bool> seen(total, false);
+    for (ull i = 0; i < total; ++i) {
+        ull ts = get(i);
+        if (ts >= total || seen[ts])
+            return false;
+        seen[ts] = true;
+    }
+    return true;
+}
+
+result run_mutex(int threads, size_t per_thread) {
+    mutex m;
+    myvector<MDT> v;
+    volatile ull sink = 0;
+    return run(
+        threads, per_thread,
+        [&](const MDT &tick) {
+            lock_guard<mutex> locker(m);
+            v.mypush(tick);
+        },
+        [&] {
+            lock_guard<mutex> locker(m);
+            if (v.size)
+                sink = v[v.size - 1].timestamp_ns;
+        },
+        [&](ull total) {
+            return v.size == total && all_present(total, [&](ull i) {
+                       return (ull)v[i].timestamp_ns;
+                   });
+        });
+}
+
+result run_concurrent(int threads, size_t per_thread) {
+    concurrent_vector<MDT> v;
+    volatile ull sink = 0;
+    return run(
+        threads, per_thread, [&](const MDT &tick) { v.mypush(tick); },
+        [&] {
+            size_t n = v.size();
+            if (n && v.ready(n - 1))
+                sink = v[n - 1].timestamp_ns;
+        },
+        [&](ull total) {
+            return v.size() == total && all_present(total, [&](ull i) {
+                       return (ull)v.at(i).timestamp_ns;
+                   });
+        });
+}
+
+void print(const char *name, const result &r) {
+    cout << "  " << name << (ull)r.appends_per_sec << " appends/sec"
+         << (r.ok ? "" : "  (CONTENTS MISMATCH)") << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t per_thread = (argc > 1) ? stoull(argv[1]) : 1000000;
+    int max_threads = (argc > 2) ? stoi(argv[2])
+                                 : max(1u, thread::hardware_concurrency());
+    cout << "appends per writer = " << per_thread
+         << ", cores = " << thread::hardware_concurrency() << "\n\n";
+
+    // 1, 2, 4, ... and always all cores last
+    for (int n = 1;; n = min(n * 2, max_threads)) {
+        cout << n << " writers + 1 reader\n";
+        print("mutex + myvector  : ", run_mutex(n, per_thread));
+        print("concurrent_vector : ", run_concurrent(n, per_thread));
+        cout << endl;
+        if (n == max_threads)
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../fundamentals/caching_pool.hpp"
+#include "../fundamentals/circular_queue.hpp"
+#include "../fundamentals/object_pool.hpp"
+
+// Shared allocators under 1..64 threads (default; pass a max):
+// - caching_pool (thread-local magazines over one slab pool)
+// - object_pool behind a mutex
+// - glibc malloc/free
+// Two patterns:
+// - local churn: every thread allocates 16 orders and frees them again
+// - handoff: threads pair up as producer/consumer like 15_multithreading.cpp,
+//   the producer allocates and sends the pointer over an spsc_cqueue, the
+//   consumer frees it (every free is cross-thread)
+
+using namespace std;
+using namespace chrono;
+
+using ull = unsigned long long;
+
+struct order {
+    ull id;
+    double price;
+    unsigned qty;
+    unsigned side;
+    ull owner;
+    ull ts;
+};
+
+struct caching_alloc {
+    caching_pool<order> pool;
+    order *allocate() { return pool.allocate(); }
+    void deallocate(order *o) { pool.deallocate(o); }
+    void thread_done() { pool.flush_thread_cache(); }
+};
+
+struct mutex_alloc {
+    mutex m;
+    object_pool<order> pool{1024};
+    order *allocate() {
+        lock_guard<mutex> locker(m);
+        return pool.allocate();
+    }
+    void deallocate(order *o) {
+        lock_guard<mutex> locker(m);
+        pool.deallocate(o);
+    }
+    void thread_done() {}
+};
+
+struct malloc_alloc {
+    order *allocate() { return static_cast<order *>(malloc(sizeof(order))); }
+    void deallocate(order *o) { free(o); }
+    void thread_done() {}
+};
+
+template <typename Alloc> double local_churn(int threads, size_t ops) {
+    Alloc alloc;
+    vector<thread> workers;
+    auto start_time = steady_clock::now();
+    for (int t = 0; t < threads; ++t)
+        workers.emplace_back([&] {
+            order *held[16];
+            for (size_t i = 0; i < ops; i += 16) {
+                for (order *&o : held) {
+                    o = alloc.allocate();
+                    o->id = i;
+                }
+                for (order *o : held)
+                    alloc.deallocate(o);
+            }
+            alloc.thread_done();
+        });
+    for (thread &w : workers)
+        w.join();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)threads * ops * 1e9 / dur.count();
+}
+
+template <typename Alloc> double handoff(int threads, size_t ops) {
+    Alloc alloc;
+    int pairs = max(1, threads / 2);
+    vector<unique_ptr<spsc_cqueue<order *>>> pipes;
+    for (int p = 0; p < pairs; ++p)
+        pipes.emplace_back(new spsc_cqueue<order *>(1024));
+    vector<thread> workers;
+    auto start_time = steady_clock::now();
+    for (int p = 0; p < pairs; ++p) {
+        spsc_cqueue<order *> &pipe = *pipes[p];
+        workers.emplace_back([&] {
+            for (size_t i = 0; i < ops; ++i) {
+                order *o = alloc.allocate();
+                o->id = i;
+                while (!pipe.try_cadd(o))
+                    this_thread::yield();
+            }
+            alloc.thread_done();
+        });
+        workers.emplace_back([&] {
+            order *o;
+            for (size_t i = 0; i < ops; ++i) {
+                while (!pipe.try_cpop(o))
+                    this_thread::yield();
+                alloc.deallocate(o);
+            }
+            alloc.thread_done();
+        });
+    }
+    for (thread &w : workers)
+        w.join();
+    auto dur = duration_cast<nanoseconds>(steady_clock::now() - start_time);
+    return (double)pairs * ops * 1e9 / dur.count();
+}
+
+int main(int argc, char **argv) {
+    size_t ops = (argc > 1) ? stoull(argv[1]) : 200000;
+    int max_threads = (argc > 2) ? stoi(argv[2]) : 64;
+    cout << "allocations per thread (per producer in handoff) = " << ops
+         << ", cores = " << thread::hardware_concurrency() << "\n\n";
+    cout << "threads\tpattern\t\tcaching_pool\tmutex pool\tmalloc   "
+            "(M allocs/sec)\n";
+
+    for (int n = 1;; n = min(n * 2, max_threads)) {
+        cout << n << "\tlocal churn\t" << local_churn<caching_alloc>(n, ops) / 1e6
+             << "\t\t" << local_churn<mutex_alloc>(n, ops) / 1e6 << "\t\t"
+             << local_churn<malloc_alloc>(n, ops) / 1e6 << "\n";
+        if (n >= 2)
+            cout << n << "\thandoff\t\t" << handoff<caching_alloc>(n, ops) / 1e6
+                 << "\t\t" << handoff<mutex_alloc>(n, ops) / 1e6 << "\t\t"
+                 << handoff<malloc_alloc>(n, ops) / 1e6 << "\n";
+        if (n == max_threads)
+            break;
+    }
+    return 0;
+}